@@ -0,0 +1,75 @@
+/**
+ * @file analytic.cpp
+ * @author Mathias LE BOUEDEC - Lilou MALFOY
+ * @date 2025
+ * @brief Implémentation des formules fermées de Black-Scholes
+ */
+
+#include "analytic.hpp"
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+
+/**
+ * @brief Fonction de répartition de la loi normale centrée réduite
+ * @param x Point d'évaluation
+ * @return P(Z <= x)
+ */
+double normal_cdf(double x) {
+    return 0.5 * std::erfc(-x / std::sqrt(2.0));
+}
+
+/**
+ * @brief Prix de Black-Scholes d'un call européen
+ * @param S Prix de l'actif sous-jacent
+ * @param K Strike de l'option
+ * @param r Taux d'intérêt sans risque
+ * @param sigma Volatilité de l'actif sous-jacent
+ * @param tau Temps restant avant maturité
+ * @return Prix du call
+ */
+double black_scholes_call(double S, double K, double r, double sigma, double tau) {
+    if (tau <= 0.0 || sigma <= 0.0 || S <= 0.0) {
+        return std::max(S - K * std::exp(-r * std::max(tau, 0.0)), 0.0); //cas dégénéré : valeur intrinsèque actualisée
+    }
+    double sq = sigma * std::sqrt(tau);
+    double d1 = (std::log(S / K) + (r + 0.5 * sigma * sigma) * tau) / sq;
+    double d2 = d1 - sq;
+    return S * normal_cdf(d1) - K * std::exp(-r * tau) * normal_cdf(d2);
+}
+
+/**
+ * @brief Prix de Black-Scholes d'un put européen
+ * @param S Prix de l'actif sous-jacent
+ * @param K Strike de l'option
+ * @param r Taux d'intérêt sans risque
+ * @param sigma Volatilité de l'actif sous-jacent
+ * @param tau Temps restant avant maturité
+ * @return Prix du put
+ */
+double black_scholes_put(double S, double K, double r, double sigma, double tau) {
+    if (tau <= 0.0 || sigma <= 0.0 || S <= 0.0) {
+        return std::max(K * std::exp(-r * std::max(tau, 0.0)) - S, 0.0);
+    }
+    double sq = sigma * std::sqrt(tau);
+    double d1 = (std::log(S / K) + (r + 0.5 * sigma * sigma) * tau) / sq;
+    double d2 = d1 - sq;
+    return K * std::exp(-r * tau) * normal_cdf(-d2) - S * normal_cdf(-d1);
+}
+
+/**
+ * @brief Prix de Black-Scholes à t=0 de l'option décrite par une EDP
+ * @param edp EDP contenant l'option (Call ou Put) et les paramètres du marché
+ * @param S Prix de l'actif sous-jacent
+ * @return Prix de l'option
+ */
+double black_scholes_price(const EDP& edp, double S) {
+    const Option* option = edp.getOption();
+    if (dynamic_cast<const Call*>(option) != nullptr) {
+        return black_scholes_call(S, option->getK(), edp.getR(), edp.getSigma(), edp.getT());
+    }
+    if (dynamic_cast<const Put*>(option) != nullptr) {
+        return black_scholes_put(S, option->getK(), edp.getR(), edp.getSigma(), edp.getT());
+    }
+    throw std::invalid_argument("black_scholes_price : formule fermée disponible uniquement pour Call et Put");
+}
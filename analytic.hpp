@@ -0,0 +1,53 @@
+/**
+ * @file analytic.hpp
+ * @author Mathias LE BOUEDEC - Lilou MALFOY
+ * @date 2025
+ * @brief Formules fermées de Black-Scholes pour les options européennes (prix de référence)
+ */
+
+#ifndef ANALYTIC_HPP
+#define ANALYTIC_HPP
+
+#include "edp.hpp"
+
+
+/**
+ * @brief Fonction de répartition de la loi normale centrée réduite
+ * @param x Point d'évaluation
+ * @return P(Z <= x)
+ */
+double normal_cdf(double x);
+
+/**
+ * @brief Prix de Black-Scholes d'un call européen
+ * @param S Prix de l'actif sous-jacent
+ * @param K Strike de l'option
+ * @param r Taux d'intérêt sans risque
+ * @param sigma Volatilité de l'actif sous-jacent
+ * @param tau Temps restant avant maturité
+ * @return Prix du call
+ */
+double black_scholes_call(double S, double K, double r, double sigma, double tau);
+
+/**
+ * @brief Prix de Black-Scholes d'un put européen
+ * @param S Prix de l'actif sous-jacent
+ * @param K Strike de l'option
+ * @param r Taux d'intérêt sans risque
+ * @param sigma Volatilité de l'actif sous-jacent
+ * @param tau Temps restant avant maturité
+ * @return Prix du put
+ */
+double black_scholes_put(double S, double K, double r, double sigma, double tau);
+
+/**
+ * @brief Prix de Black-Scholes à t=0 de l'option décrite par une EDP
+ * @param edp EDP contenant l'option (Call ou Put) et les paramètres du marché
+ * @param S Prix de l'actif sous-jacent
+ * @return Prix de l'option
+ * @throw std::invalid_argument si l'option n'est ni un Call ni un Put
+ */
+double black_scholes_price(const EDP& edp, double S);
+
+
+#endif // ANALYTIC_HPP
@@ -0,0 +1,92 @@
+/**
+ * @file bench_adjoint.cpp
+ * @author Mathias LE BOUEDEC - Lilou MALFOY
+ * @date 2025
+ * @brief Sensibilités adjointes de Cranck_nicolson contre différences finies centrées : écart et coût
+ *
+ * Le pas des différences finies est petit (1e-6) pour qu'en mode adaptatif les solutions voisines
+ * gardent la même grille en temps : l'adjoint dérive la marche à grille fixée. Le programme renvoie 1
+ * si un écart relatif dépasse 1e-6.
+ *
+ * Compilation : g++ -O2 -pthread bench_adjoint.cpp solver.cpp simd_math.cpp domain.cpp time_stepping.cpp workspace.cpp
+ *               edp.cpp payoff.cpp term_structure.cpp analytic.cpp -o bench_adjoint
+ */
+
+#include <iostream>
+#include <iomanip>
+#include <string>
+#include <chrono>
+#include <cmath>
+#include <algorithm>
+#include "payoff.hpp"
+#include "edp.hpp"
+#include "solver.hpp"
+
+/**
+ * @brief Configuration d'une ligne du tableau
+ */
+struct Adjoint_case {
+    std::string name;    // Nom de la ligne
+    Time_scheme scheme;  // Schéma en temps
+    double tolerance;    // Tolérance du pas adaptatif (0 : pas fixe)
+};
+
+/**
+ * @brief Résout puis renvoie les sensibilités adjointes au spot
+ * @param put true pour un put, false pour un call
+ * @param sigma Volatilité
+ * @param r Taux
+ * @param c Configuration
+ * @param S0 Spot
+ * @return Prix et sensibilités
+ */
+static Adjoint_sensitivities run(bool put, double sigma, double r, const Adjoint_case& c, double S0) {
+    const double K = 100.0, L = 400.0, T = 1.0;
+    Call call(K, L, r, T);
+    Put put_option(K, L, r, T);
+    EDP edp(put ? static_cast<Option*>(&put_option) : static_cast<Option*>(&call), sigma, r, T, L);
+    Cranck_nicolson solver(edp, 400, 200);
+    solver.set_time_scheme(c.scheme);
+    if (c.tolerance > 0.0) solver.set_adaptive(c.tolerance);
+    solver.solve();
+    return solver.adjoint(S0);
+}
+
+int main() {
+    const double sigma = 0.2, r = 0.05, S0 = 100.0, h = 1e-6;
+    const Adjoint_case cases[] = {
+        {"Crank-Nicolson", SCHEME_CRANK_NICOLSON, 0.0},
+        {"implicite", SCHEME_IMPLICIT, 0.0},
+        {"Rannacher", SCHEME_RANNACHER, 0.0},
+        {"CN adaptatif 1e-4", SCHEME_CRANK_NICOLSON, 1e-4},
+        {"implicite adaptatif 1e-4", SCHEME_IMPLICIT, 1e-4},
+    };
+    double worst = 0.0;
+
+    std::cout << std::setprecision(8);
+    std::cout << std::setw(26) << "schéma" << std::setw(6) << "type" << std::setw(14) << "vega adj" << std::setw(12) << "écart rel"
+              << std::setw(14) << "rho adj" << std::setw(12) << "écart rel" << std::setw(14) << "adj / DF" << std::endl;
+    for (const Adjoint_case& c : cases) {
+        for (int put = 0; put < 2; ++put) {
+            std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+            Adjoint_sensitivities adj = run(put, sigma, r, c, S0);
+            double adjoint_ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+
+            //quatre résolutions pour les deux différences centrées
+            start = std::chrono::steady_clock::now();
+            double vega = (run(put, sigma + h, r, c, S0).value - run(put, sigma - h, r, c, S0).value) / (2.0 * h);
+            double rho = (run(put, sigma, r + h, c, S0).value - run(put, sigma, r - h, c, S0).value) / (2.0 * h);
+            double fd_ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+
+            double err_vega = std::abs(adj.dsigma - vega) / std::abs(vega);
+            double err_rho = std::abs(adj.dr - rho) / std::abs(rho);
+            worst = std::max(worst, std::max(err_vega, err_rho));
+            std::cout << std::setw(26) << c.name << std::setw(6) << (put ? "put" : "call")
+                      << std::setw(14) << adj.dsigma << std::setw(12) << std::setprecision(2) << err_vega
+                      << std::setw(14) << std::setprecision(8) << adj.dr << std::setw(12) << std::setprecision(2) << err_rho
+                      << std::setw(14) << adjoint_ms / fd_ms << std::setprecision(8) << std::endl;
+        }
+    }
+    std::cout << "écart relatif maximal : " << worst << std::endl;
+    return (worst > 1e-6) ? 1 : 0;
+}
@@ -0,0 +1,146 @@
+/**
+ * @file bench_capi.c
+ * @author Mathias LE BOUEDEC - Lilou MALFOY
+ * @date 2025
+ * @brief Appel de l'interface C depuis un programme C : lot en structure de tableaux, un puis plusieurs threads
+ *
+ * Compilation : g++ -O2 -fPIC -shared -fvisibility=hidden -pthread bs_capi.cpp solver.cpp simd_math.cpp domain.cpp
+ *                   time_stepping.cpp workspace.cpp edp.cpp payoff.cpp term_structure.cpp analytic.cpp -o libbs.so
+ *               gcc -O2 -pthread bench_capi.c -L. -lbs -Wl,-rpath,. -lm -o bench_capi
+ */
+
+#include <math.h>
+#include <pthread.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include "bs_capi.h"
+
+#define N_OPTIONS 2000
+#define N_THREADS 4
+
+/**
+ * @brief Lot d'options en structure de tableaux, avec ses sorties
+ */
+typedef struct Batch {
+    int type[N_OPTIONS];
+    double K[N_OPTIONS], sigma[N_OPTIONS], r[N_OPTIONS], T[N_OPTIONS], spot[N_OPTIONS];
+    double price[N_OPTIONS], delta[N_OPTIONS], gamma[N_OPTIONS], theta[N_OPTIONS], vega[N_OPTIONS], rho[N_OPTIONS];
+    int status[N_OPTIONS];
+    bs_grid_config grid;
+} Batch;
+
+/**
+ * @brief Tranche du lot traitée par un thread
+ */
+typedef struct Slice {
+    Batch* batch;
+    size_t begin, end;
+} Slice;
+
+/**
+ * @brief Temps écoulé en secondes
+ * @param start Instant de départ
+ * @return Durée en secondes
+ */
+static double elapsed(const struct timespec* start) {
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (now.tv_sec - start->tv_sec) + 1e-9 * (now.tv_nsec - start->tv_nsec);
+}
+
+/**
+ * @brief Prix de Black-Scholes en formule fermée
+ * @param is_call Call ou put
+ * @param S Spot
+ * @param K Strike
+ * @param r Taux
+ * @param sigma Volatilité
+ * @param T Maturité
+ * @return Prix
+ */
+static double black_scholes(int is_call, double S, double K, double r, double sigma, double T) {
+    double d1 = (log(S / K) + (r + 0.5 * sigma * sigma) * T) / (sigma * sqrt(T));
+    double d2 = d1 - sigma * sqrt(T);
+    double call = S * 0.5 * erfc(-d1 / sqrt(2.0)) - K * exp(-r * T) * 0.5 * erfc(-d2 / sqrt(2.0));
+    return is_call ? call : call - S + K * exp(-r * T);
+}
+
+/**
+ * @brief Corps d'un thread : appelle l'interface sur sa tranche (tableaux de sortie disjoints)
+ * @param arg Tranche
+ * @return NULL
+ */
+static void* run_slice(void* arg) {
+    Slice* s = (Slice*)arg;
+    Batch* b = s->batch;
+    size_t i = s->begin, n = s->end - s->begin;
+    bs_price_batch(n, b->type + i, b->K + i, b->sigma + i, b->r + i, b->T + i, b->spot + i, &b->grid,
+                   b->price + i, b->delta + i, b->gamma + i, b->theta + i, b->vega + i, b->rho + i, b->status + i);
+    return NULL;
+}
+
+int main(void) {
+    static Batch single, threaded;
+    size_t i;
+    int t;
+    for (i = 0; i < N_OPTIONS; ++i) {
+        single.type[i] = (i % 2 == 0) ? BS_CALL : BS_PUT;
+        single.K[i] = 80.0 + 40.0 * (double)(i % 101) / 100.0;
+        single.sigma[i] = 0.15 + 0.1 * (double)(i % 7) / 6.0;
+        single.r[i] = 0.01 + 0.04 * (double)(i % 5) / 4.0;
+        single.T[i] = 0.25 + 1.75 * (double)(i % 11) / 10.0;
+        single.spot[i] = 100.0;
+    }
+    bs_default_grid(&single.grid);
+    single.grid.greeks = BS_GREEK_VEGA_RHO;
+    threaded = single;
+    printf("interface C version %d, %d options, grille %d x %d\n", bs_abi_version(), N_OPTIONS, single.grid.N, single.grid.M);
+
+    /* un thread : le premier appel remplit le pool, le second ne fait plus d'allocation */
+    struct timespec start;
+    Slice all = {&single, 0, N_OPTIONS};
+    run_slice(&all);
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    run_slice(&all);
+    double one = elapsed(&start);
+
+    /* plusieurs threads, chacun sur sa tranche */
+    pthread_t threads[N_THREADS];
+    Slice slices[N_THREADS];
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    for (t = 0; t < N_THREADS; ++t) {
+        slices[t].batch = &threaded;
+        slices[t].begin = (size_t)t * N_OPTIONS / N_THREADS;
+        slices[t].end = (size_t)(t + 1) * N_OPTIONS / N_THREADS;
+        pthread_create(&threads[t], NULL, run_slice, &slices[t]);
+    }
+    for (t = 0; t < N_THREADS; ++t) pthread_join(threads[t], NULL);
+    double many = elapsed(&start);
+
+    double worst = 0.0;
+    int same = 1, failed = 0;
+    for (i = 0; i < N_OPTIONS; ++i) {
+        double exact = black_scholes(single.type[i] == BS_CALL, single.spot[i], single.K[i], single.r[i], single.sigma[i], single.T[i]);
+        if (fabs(single.price[i] - exact) > worst) worst = fabs(single.price[i] - exact);
+        same = same && single.price[i] == threaded.price[i] && single.vega[i] == threaded.vega[i];
+        failed += single.status[i] != BS_OK;
+    }
+    printf("1 thread : %.1f us / option, %d threads : %.1f us / option\n", 1e6 * one / N_OPTIONS, N_THREADS, 1e6 * many / N_OPTIONS);
+    printf("écart max à Black-Scholes : %.2e, échecs : %d, résultats multi-threads %s\n", worst, failed,
+           same ? "identiques" : "DIFFÉRENTS");
+    printf("option 0 : prix %.6f delta %.6f gamma %.6f theta %.6f vega %.6f rho %.6f\n", single.price[0], single.delta[0],
+           single.gamma[0], single.theta[0], single.vega[0], single.rho[0]);
+
+    /* paramètre invalide : état par option, pas d'exception */
+    int bad_type = 7;
+    double one_value = 1.0, price, zero = 0.0;
+    int status;
+    int n_bad = bs_price_batch(1, &bad_type, &one_value, &one_value, &zero, &one_value, &one_value, NULL,
+                               &price, NULL, NULL, NULL, NULL, NULL, &status);
+    printf("type invalide : %d échec, état \"%s\", prix %f\n", n_bad, bs_status_message(status), price);
+
+    /* ce thread a fini : sa mémoire de travail est rendue au système */
+    bs_release_thread_cache();
+    return 0;
+}
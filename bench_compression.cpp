@@ -0,0 +1,67 @@
+/**
+ * @file bench_compression.cpp
+ * @author Mathias LE BOUEDEC - Lilou MALFOY
+ * @date 2025
+ * @brief Taux de compression, erreur garantie et coût de décompression des surfaces conservées
+ *
+ * Compilation : g++ -O2 -pthread bench_compression.cpp compressed_surface.cpp solver.cpp simd_math.cpp domain.cpp time_stepping.cpp
+ *               workspace.cpp edp.cpp payoff.cpp term_structure.cpp analytic.cpp -o bench_compression
+ */
+
+#include <iostream>
+#include <iomanip>
+#include <string>
+#include <vector>
+#include <chrono>
+#include "payoff.hpp"
+#include "edp.hpp"
+#include "solver.hpp"
+#include "compressed_surface.hpp"
+
+/**
+ * @brief Compresse une surface, puis mesure la décompression ligne par ligne
+ * @param name Nom du format
+ * @param v Surface
+ * @param mode Format de compression
+ * @param max_error Erreur absolue demandée (mode quantifié)
+ */
+static void report(const std::string& name, const std::vector< std::vector<double> >& v, Compression mode, double max_error) {
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    Compressed_surface c(v, mode, max_error);
+    double compress_ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+
+    std::vector<double> row;
+    double check = 0.0;
+    start = std::chrono::steady_clock::now();
+    for (std::size_t j = 0; j < c.rows(); ++j) {
+        c.decompress_row(j, row);
+        check += row[row.size() / 2];
+    }
+    double row_us = std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count() / c.rows();
+
+    std::cout << std::setw(16) << name << std::setw(12) << c.max_error() << std::setw(12) << c.bytes() / 1024
+              << std::setw(10) << c.compression_ratio() << std::setw(14) << compress_ms << std::setw(14) << row_us
+              << (check != check ? " nan" : "") << std::endl;
+}
+
+int main() {
+    double K = 100.0, L = 300.0, sigma = 0.2, r = 0.05, T = 1.0;
+    int N = 2000, M = 1000;
+
+    Call call(K, L, r, T);
+    EDP edp(&call, sigma, r, T, L);
+    Cranck_nicolson solver(edp, N, M);
+    solver.set_time_scheme(SCHEME_RANNACHER);
+    solver.solve();
+    const std::vector< std::vector<double> >& v = solver.get_surface();
+
+    std::cout << "surface " << M + 1 << " x " << N + 1 << " : " << (M + 1) * (N + 1) * sizeof(double) / 1024 << " Kio en double" << std::endl;
+    std::cout << std::setw(16) << "format" << std::setw(12) << "err. max" << std::setw(12) << "Kio"
+              << std::setw(10) << "taux" << std::setw(14) << "compr. (ms)" << std::setw(14) << "ligne (us)" << std::endl;
+    report("float16", v, COMPRESS_FLOAT16, 0.0);
+    report("bfloat16", v, COMPRESS_BFLOAT16, 0.0);
+    report("quantifié 1e-3", v, COMPRESS_QUANTIZED, 1e-3);
+    report("quantifié 1e-4", v, COMPRESS_QUANTIZED, 1e-4);
+    report("quantifié 1e-6", v, COMPRESS_QUANTIZED, 1e-6);
+    return 0;
+}
@@ -0,0 +1,97 @@
+/**
+ * @file bench_cos.cpp
+ * @author Mathias LE BOUEDEC - Lilou MALFOY
+ * @date 2025
+ * @brief Comparaison du pricer COS et des solveurs EDP sur une liste de strikes
+ *
+ * Compilation : g++ -O2 bench_cos.cpp cos_method.cpp solver.cpp simd_math.cpp domain.cpp time_stepping.cpp workspace.cpp edp.cpp payoff.cpp term_structure.cpp analytic.cpp -o bench_cos
+ */
+
+#include <iostream>
+#include <iomanip>
+#include <vector>
+#include <cmath>
+#include <chrono>
+#include "payoff.hpp"
+#include "edp.hpp"
+#include "solver.hpp"
+#include "cos_method.hpp"
+#include "analytic.hpp"
+
+/**
+ * @brief Temps écoulé en millisecondes depuis un instant donné
+ * @param start Instant de départ
+ * @return Durée en millisecondes
+ */
+static double elapsed_ms(std::chrono::steady_clock::time_point start) {
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+}
+
+int main() {
+    double S0 = 100.0;
+    double L = 300.0;
+    double sigma = 0.1;
+    double r = 0.1;
+    double T = 1.0;
+    int N = 1000;
+    int M = 1000;
+
+    // Liste de strikes de 50 à 200
+    int n_strikes = 1000;
+    std::vector<double> strikes(n_strikes);
+    for (int i = 0; i < n_strikes; ++i) strikes[i] = 50.0 + 150.0 * i / (n_strikes - 1);
+
+    std::cout << std::setw(22) << "moteur" << std::setw(10) << "strikes" << std::setw(14) << "temps (ms)"
+              << std::setw(16) << "us / strike" << std::setw(16) << "erreur max" << std::endl;
+
+    // Pricer COS : termes pré-calculés une fois, puis une somme de cosinus par strike
+    Call call_ref(100.0, L, r, T);
+    EDP edp(&call_ref, sigma, r, T, L);
+    int terms[] = {32, 64, 128};
+    for (int t = 0; t < 3; ++t) {
+        Cos_pricer cos_pricer(edp, terms[t]);
+        std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+        std::vector<double> prices = cos_pricer.price_strikes(S0, strikes, true);
+        double ms = elapsed_ms(start);
+
+        double err = 0.0;
+        for (int i = 0; i < n_strikes; ++i) {
+            err = std::max(err, std::abs(prices[i] - black_scholes_call(S0, strikes[i], r, sigma, T)));
+        }
+        std::cout << std::setw(18) << "COS n=" << std::setw(4) << terms[t] << std::setw(10) << n_strikes
+                  << std::setw(14) << ms << std::setw(16) << 1000.0 * ms / n_strikes << std::setw(16) << err
+                  << "   (estimation " << cos_pricer.truncation_error() << ")" << std::endl;
+    }
+
+    // Solveurs EDP : une grille complète par strike, sur un sous-échantillon de strikes
+    int pde_stride = 50;
+    for (int engine = 0; engine < 2; ++engine) {
+        double err = 0.0;
+        int count = 0;
+        std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+        for (int i = 0; i < n_strikes; i += pde_stride) {
+            Call call(strikes[i], L, r, T);
+            EDP edp_k(&call, sigma, r, T, L);
+            double price;
+            if (engine == 0) {
+                Cranck_nicolson solver(edp_k, N, M);
+                solver.solve();
+                std::vector<double> v = solver.get_results()[0];
+                double pos = S0 / (L / N);
+                int j = static_cast<int>(pos);
+                price = v[j] + (pos - j) * (v[j + 1] - v[j]);
+            } else {
+                Implicite_solver solver(edp_k, N, M);
+                solver.solve();
+                price = solver.get_value_at_S(S0, 0);
+            }
+            err = std::max(err, std::abs(price - black_scholes_call(S0, strikes[i], r, sigma, T)));
+            ++count;
+        }
+        double ms = elapsed_ms(start);
+        std::cout << std::setw(22) << (engine == 0 ? "Crank-Nicolson" : "Implicite") << std::setw(10) << count
+                  << std::setw(14) << ms << std::setw(16) << 1000.0 * ms / count << std::setw(16) << err << std::endl;
+    }
+
+    return 0;
+}
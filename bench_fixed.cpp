@@ -0,0 +1,81 @@
+/**
+ * @file bench_fixed.cpp
+ * @author Mathias LE BOUEDEC - Lilou MALFOY
+ * @date 2025
+ * @brief Petites grilles de calibration : Fixed_cranck_nicolson<N, M> contre Cranck_nicolson, temps par résolution
+ *
+ * Compilation : g++ -O2 -pthread bench_fixed.cpp solver.cpp simd_math.cpp domain.cpp time_stepping.cpp workspace.cpp
+ *               edp.cpp payoff.cpp term_structure.cpp analytic.cpp -o bench_fixed
+ */
+
+#include <iostream>
+#include <iomanip>
+#include <chrono>
+#include <cmath>
+#include <algorithm>
+#include "payoff.hpp"
+#include "edp.hpp"
+#include "solver.hpp"
+#include "fixed_solver.hpp"
+
+/**
+ * @brief Balaye des volatilités comme une boucle de calibration, avec les deux solveurs, et affiche une ligne
+ * @tparam N Nombre de pas en S
+ * @tparam M Nombre de pas de temps
+ * @param solves Nombre de résolutions par solveur
+ */
+template <int N, int M>
+void compare(int solves) {
+    const double K = 100.0, L = 400.0, r = 0.03, T = 1.0;
+    double dynamic_sum = 0.0, fixed_sum = 0.0, worst = 0.0;
+
+    //solveur dynamique : construit à chaque essai, comme dans un objectif de calibration
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    for (int k = 0; k < solves; ++k) {
+        double sigma = 0.1 + 0.3 * (k % 97) / 96.0;
+        Put put(K, L, r, T);
+        EDP edp(&put, sigma, r, T, L);
+        Cranck_nicolson solver(edp, N, M);
+        solver.set_time_scheme(SCHEME_RANNACHER, 2);
+        solver.solve();
+        dynamic_sum += solver.get_surface()[0][N / 4];
+    }
+    double dynamic_us = std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count() / solves;
+
+    start = std::chrono::steady_clock::now();
+    for (int k = 0; k < solves; ++k) {
+        double sigma = 0.1 + 0.3 * (k % 97) / 96.0;
+        Put put(K, L, r, T);
+        EDP edp(&put, sigma, r, T, L);
+        Fixed_cranck_nicolson<N, M> solver(edp);
+        solver.set_time_scheme(SCHEME_RANNACHER, 2);
+        solver.solve();
+        fixed_sum += solver.get_row()[N / 4];
+    }
+    double fixed_us = std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count() / solves;
+
+    //écart ligne complète sur une volatilité
+    Put put(K, L, r, T);
+    EDP edp(&put, 0.25, r, T, L);
+    Cranck_nicolson dynamic(edp, N, M);
+    dynamic.set_time_scheme(SCHEME_RANNACHER, 2);
+    dynamic.solve();
+    Fixed_cranck_nicolson<N, M> fixed(edp);
+    fixed.solve();
+    for (int i = 0; i <= N; ++i) worst = std::max(worst, std::abs(dynamic.get_surface()[0][i] - fixed.get_row()[i]));
+
+    std::cout << std::setw(5) << N << std::setw(5) << M << std::setw(14) << dynamic_us << std::setw(14) << fixed_us
+              << std::setw(10) << dynamic_us / fixed_us << std::setw(14) << worst
+              << std::setw(14) << std::abs(dynamic_sum - fixed_sum) << std::endl;
+}
+
+int main() {
+    std::cout << std::setprecision(4);
+    std::cout << std::setw(5) << "N" << std::setw(5) << "M" << std::setw(14) << "dynamique us" << std::setw(14) << "fixe us"
+              << std::setw(10) << "gain" << std::setw(14) << "écart max" << std::setw(14) << "écart somme" << std::endl;
+    compare<50, 50>(40000);
+    compare<100, 100>(10000);
+    compare<200, 100>(5000);
+    compare<200, 200>(3000);
+    return 0;
+}
@@ -0,0 +1,66 @@
+/**
+ * @file bench_maturities.cpp
+ * @author Mathias LE BOUEDEC - Lilou MALFOY
+ * @date 2025
+ * @brief Gamme de maturités : une marche jusqu'à la plus longue contre une résolution par maturité
+ *
+ * Compilation : g++ -O2 -pthread bench_maturities.cpp solver.cpp simd_math.cpp domain.cpp time_stepping.cpp workspace.cpp
+ *               edp.cpp payoff.cpp term_structure.cpp analytic.cpp -o bench_maturities
+ */
+
+#include <iostream>
+#include <iomanip>
+#include <vector>
+#include <chrono>
+#include <cmath>
+#include "payoff.hpp"
+#include "edp.hpp"
+#include "solver.hpp"
+#include "analytic.hpp"
+
+int main() {
+    double K = 100.0, L = 400.0, sigma = 0.2, r = 0.03;
+    int N = 800;
+    double steps_per_year = 400.0;
+
+    //1M, 3M, 6M, 9M, 1A, 18M, 2A, 3A, 5A
+    double strip[] = {1.0 / 12.0, 0.25, 0.5, 0.75, 1.0, 1.5, 2.0, 3.0, 5.0};
+    std::vector<double> maturities(strip, strip + 9);
+    double spots_[] = {80.0, 100.0, 120.0};
+    std::vector<double> spots(spots_, spots_ + 3);
+    double T = maturities.back();
+
+    //une résolution par maturité, même pas de temps
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    std::vector< std::vector<double> > separate(maturities.size(), std::vector<double>(spots.size()));
+    for (std::size_t m = 0; m < maturities.size(); ++m) {
+        Call call(K, L, r, maturities[m]);
+        EDP edp(&call, sigma, r, maturities[m], L);
+        Implicite_solver solver(edp, N, static_cast<int>(std::ceil(steps_per_year * maturities[m])));
+        solver.set_time_scheme(SCHEME_RANNACHER);
+        solver.solve();
+        for (std::size_t k = 0; k < spots.size(); ++k) separate[m][k] = solver.get_value_at_S(spots[k], 0);
+    }
+    double separate_ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+
+    //une seule marche jusqu'à la plus longue maturité
+    start = std::chrono::steady_clock::now();
+    Call call(K, L, r, T);
+    EDP edp(&call, sigma, r, T, L);
+    Implicite_solver solver(edp, N, static_cast<int>(std::ceil(steps_per_year * T)));
+    solver.set_time_scheme(SCHEME_RANNACHER);
+    std::vector< std::vector<double> > strip_prices = solver.solve_maturities(maturities, spots);
+    double strip_ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+
+    std::cout << std::setw(10) << "maturité" << std::setw(8) << "spot" << std::setw(14) << "Black-Scholes"
+              << std::setw(14) << "écart séparé" << std::setw(14) << "écart gamme" << std::endl;
+    for (std::size_t m = 0; m < maturities.size(); ++m) {
+        for (std::size_t k = 0; k < spots.size(); ++k) {
+            double exact = black_scholes_call(spots[k], K, r, sigma, maturities[m]);
+            std::cout << std::setw(10) << maturities[m] << std::setw(8) << spots[k] << std::setw(14) << exact
+                      << std::setw(14) << separate[m][k] - exact << std::setw(14) << strip_prices[m][k] - exact << std::endl;
+        }
+    }
+    std::cout << "séparé : " << separate_ms << " ms, gamme en une marche : " << strip_ms << " ms" << std::endl;
+    return 0;
+}
@@ -0,0 +1,62 @@
+/**
+ * @file bench_parareal.cpp
+ * @author Mathias LE BOUEDEC - Lilou MALFOY
+ * @date 2025
+ * @brief Marche parareal contre marche série de Crank-Nicolson sur une maturité longue
+ *
+ * Compilation : g++ -O2 -pthread bench_parareal.cpp solver.cpp simd_math.cpp domain.cpp time_stepping.cpp workspace.cpp edp.cpp payoff.cpp term_structure.cpp analytic.cpp -o bench_parareal
+ * Utilisation : ./bench_parareal [nombre de threads]
+ */
+
+#include <iostream>
+#include <iomanip>
+#include <cstdlib>
+#include <cmath>
+#include <vector>
+#include <chrono>
+#include "payoff.hpp"
+#include "edp.hpp"
+#include "solver.hpp"
+
+int main(int argc, char** argv) {
+    int n_threads = (argc > 1) ? std::atoi(argv[1]) : 0;
+
+    double K = 100.0, sigma = 0.2, r = 0.05, T = 10.0;
+    int N = 400, M = 8000;
+    std::vector<double> spots(1, K);
+
+    Call call(K, 1000.0, r, T);
+    EDP edp(&call, sigma, r, T, 1000.0);
+
+    //marche série de référence
+    Cranck_nicolson serial(edp, N, M);
+    serial.set_auto_domain(spots);
+    serial.set_time_scheme(SCHEME_RANNACHER);
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    serial.solve();
+    double serial_ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    std::vector<double> reference = serial.get_results()[0];
+    std::cout << "série : " << serial_ms << " ms, M = " << M << std::endl;
+
+    std::cout << std::setw(8) << "tranches" << std::setw(9) << "threads" << std::setw(7) << "iter"
+              << std::setw(14) << "correction" << std::setw(14) << "écart t=0" << std::setw(12) << "temps (ms)"
+              << std::setw(12) << "accél." << std::setw(12) << "modèle" << std::endl;
+    int slices[] = {8, 16, 32, 64};
+    for (int k = 0; k < 4; ++k) {
+        Cranck_nicolson solver(edp, N, M);
+        solver.set_auto_domain(spots);
+        solver.set_time_scheme(SCHEME_RANNACHER);
+        solver.set_parareal(slices[k], 1e-6, n_threads);
+        solver.solve();
+        Parareal_stats stats = solver.get_parareal_stats();
+
+        std::vector<double> v = solver.get_results()[0];
+        double diff = 0.0;
+        for (int i = 0; i <= N; ++i) diff = std::max(diff, std::abs(v[i] - reference[i]));
+
+        std::cout << std::setw(8) << stats.slices << std::setw(9) << stats.threads << std::setw(7) << stats.iterations
+                  << std::setw(14) << stats.correction << std::setw(14) << diff << std::setw(12) << stats.wall_ms
+                  << std::setw(12) << serial_ms / stats.wall_ms << std::setw(12) << stats.model_speedup << std::endl;
+    }
+    return 0;
+}
@@ -0,0 +1,108 @@
+/**
+ * @file bench_shards.cpp
+ * @author Mathias LE BOUEDEC - Lilou MALFOY
+ * @date 2025
+ * @brief Portefeuille réparti sur plusieurs processus : débit, équilibrage des lots et relance après un échec
+ *
+ * Compilation : g++ -O2 -pthread bench_shards.cpp shard_coordinator.cpp solver.cpp simd_math.cpp domain.cpp time_stepping.cpp
+ *               workspace.cpp edp.cpp payoff.cpp term_structure.cpp analytic.cpp -lrt -o bench_shards
+ */
+
+#include <iostream>
+#include <iomanip>
+#include <vector>
+#include <cmath>
+#include <algorithm>
+#include <unistd.h>
+#include "shard_coordinator.hpp"
+#include "analytic.hpp"
+
+/**
+ * @brief Prix au spot par interpolation linéaire sur une tranche
+ * @param slice Tranche à t=0
+ * @param S0 Spot
+ * @return Prix interpolé
+ */
+static double price_at(const Price_slice& slice, double S0) {
+    double x = (S0 - slice.s_low) / slice.dS;
+    int i = std::min(std::max(static_cast<int>(x), 0), static_cast<int>(slice.price.size()) - 2);
+    return slice.price[i] + (x - i) * (slice.price[i + 1] - slice.price[i]);
+}
+
+/**
+ * @brief Exécute le portefeuille et affiche le bilan
+ * @param coordinator Coordinateur
+ * @param portfolio Portefeuille
+ * @return Tranches obtenues
+ */
+static std::vector<Price_slice> report(Shard_coordinator& coordinator, const std::vector<Option_spec>& portfolio) {
+    std::vector<Price_slice> slices = coordinator.run(portfolio);
+    const Shard_report& r = coordinator.report();
+
+    double worst = 0.0;
+    for (std::size_t j = 0; j < slices.size(); ++j) {
+        if (!slices[j].ok) continue;
+        const Option_spec& o = portfolio[j];
+        double exact = o.is_call ? black_scholes_call(o.K, o.K, o.r, o.sigma, o.T) : black_scholes_put(o.K, o.K, o.r, o.sigma, o.T);
+        worst = std::max(worst, std::abs(price_at(slices[j], o.K) - exact));
+    }
+    double longest = *std::max_element(r.shard_seconds.begin(), r.shard_seconds.end());
+    double mean = 0.0;
+    for (std::size_t s = 0; s < r.shard_seconds.size(); ++s) mean += r.shard_seconds[s] / r.shard_seconds.size();
+
+    std::cout << std::setw(10) << r.workers << std::setw(10) << r.seconds * 1e3 << std::setw(12) << r.options_per_second
+              << std::setw(14) << r.cells_per_second / 1e6 << std::setw(14) << longest / mean
+              << std::setw(10) << r.retries << std::setw(8) << r.failed << std::setw(14) << worst << std::endl;
+    if (r.inline_shards > 0) std::cout << "  (" << r.inline_shards << " lot(s) résolu(s) en série : fork a échoué)" << std::endl;
+    return slices;
+}
+
+int main() {
+    //portefeuille hétérogène : les grilles vont de 200 x 50 à 1600 x 400
+    std::vector<Option_spec> portfolio;
+    for (int k = 0; k < 240; ++k) {
+        Option_spec o;
+        o.is_call = (k % 2 == 0);
+        o.K = 80.0 + (k % 9) * 5.0;
+        o.sigma = 0.15 + 0.05 * (k % 4);
+        o.r = 0.02 + 0.01 * (k % 3);
+        o.T = 0.25 + 0.25 * (k % 8);
+        o.L = 4.0 * o.K;
+        int level = k % 4;
+        o.N = 200 << level;
+        o.M = 50 << level;
+        portfolio.push_back(o);
+    }
+
+    long cores = sysconf(_SC_NPROCESSORS_ONLN);
+    std::cout << portfolio.size() << " options, " << cores << " coeurs" << std::endl;
+    std::cout << std::setw(10) << "processus" << std::setw(10) << "ms" << std::setw(12) << "options/s"
+              << std::setw(14) << "Mnoeuds/s" << std::setw(14) << "max/moyenne" << std::setw(10) << "relances"
+              << std::setw(8) << "échecs" << std::setw(14) << "écart max BS" << std::endl;
+
+    std::vector<Price_slice> reference;
+    for (int workers = 1; workers <= std::max(4L, cores); workers *= 2) {
+        Shard_coordinator coordinator(workers);
+        std::vector<Price_slice> slices = report(coordinator, portfolio);
+        if (reference.empty()) reference = slices;
+    }
+
+    //le lot 1 est tué après 5 options : ses options restantes sont relancées dans un nouveau processus
+    Shard_coordinator coordinator(4);
+    coordinator.set_fault_injection(1, 5);
+    std::vector<Price_slice> slices = report(coordinator, portfolio);
+    bool same = true;
+    for (std::size_t j = 0; j < slices.size(); ++j) same = same && slices[j].ok && slices[j].price == reference[j].price;
+    std::cout << "après relance : résultats " << (same ? "identiques" : "DIFFÉRENTS") << " à l'exécution sur 1 processus" << std::endl;
+
+    //le lot 2 se bloque après 5 options : il est tué au délai de 2 s puis relancé
+    Shard_coordinator stuck(4);
+    stuck.set_attempt_timeout(2.0);
+    stuck.set_fault_injection(2, 5, true);
+    slices = report(stuck, portfolio);
+    same = true;
+    for (std::size_t j = 0; j < slices.size(); ++j) same = same && slices[j].ok && slices[j].price == reference[j].price;
+    std::cout << "après délai (" << stuck.report().timeouts << " processus tué) : résultats "
+              << (same ? "identiques" : "DIFFÉRENTS") << std::endl;
+    return 0;
+}
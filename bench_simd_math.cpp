@@ -0,0 +1,104 @@
+/**
+ * @file bench_simd_math.cpp
+ * @author Mathias LE BOUEDEC - Lilou MALFOY
+ * @date 2025
+ * @brief Noyaux exp et log sur des tableaux : erreur en ULP, débit face à std::exp / std::log, coût du solveur implicite
+ *
+ * Compilation : g++ -O2 -pthread bench_simd_math.cpp simd_math.cpp solver.cpp domain.cpp time_stepping.cpp workspace.cpp
+ *               edp.cpp payoff.cpp term_structure.cpp analytic.cpp -o bench_simd_math
+ */
+
+#include <iostream>
+#include <iomanip>
+#include <vector>
+#include <random>
+#include <chrono>
+#include <cmath>
+#include "simd_math.hpp"
+#include "payoff.hpp"
+#include "edp.hpp"
+#include "solver.hpp"
+
+/**
+ * @brief Écart en ULP par rapport à une référence en précision étendue
+ * @param y Valeur calculée
+ * @param ref Référence
+ * @return |y - ref| en unités du dernier chiffre de ref arrondi au double
+ */
+static double ulp_error(double y, long double ref) {
+    double r = static_cast<double>(ref);
+    double ulp = std::nextafter(std::abs(r), INFINITY) - std::abs(r);
+    return static_cast<double>(std::abs(static_cast<long double>(y) - ref) / ulp);
+}
+
+/**
+ * @brief Mesure le temps par valeur d'un noyau sur un tableau qui tient en cache
+ * @param kernel Noyau tableau
+ * @param scalar Fonction scalaire de la bibliothèque standard
+ * @param x Arguments
+ * @param vector_ns Temps par valeur du noyau
+ * @param std_ns Temps par valeur de la boucle scalaire
+ */
+static void time_kernel(void (*kernel)(const double*, double*, std::size_t), double (*scalar)(double),
+                        const std::vector<double>& x, double& vector_ns, double& std_ns) {
+    const int repeats = 20000;
+    std::vector<double> y(x.size());
+    double check = 0.0;
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    for (int k = 0; k < repeats; ++k) {
+        kernel(&x[0], &y[0], x.size());
+        check += y[k % x.size()];
+    }
+    vector_ns = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count() / (repeats * x.size());
+    start = std::chrono::steady_clock::now();
+    for (int k = 0; k < repeats; ++k) {
+        for (std::size_t i = 0; i < x.size(); ++i) y[i] = scalar(x[i]);
+        check += y[k % x.size()];
+    }
+    std_ns = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count() / (repeats * x.size());
+    if (check != check) std::cout << "nan" << std::endl;
+}
+
+static double std_exp(double x) { return std::exp(x); }
+static double std_log(double x) { return std::log(x); }
+
+int main() {
+    std::mt19937_64 gen(42);
+    std::uniform_real_distribution<double> wide(-708.0, 709.0), grid(-12.0, 8.0);
+
+    //erreur maximale sur 4 millions de tirages, références en long double
+    const std::size_t n = 4000000;
+    std::vector<double> x(n), y(n);
+    double exp_ulp = 0.0, log_ulp = 0.0;
+    for (std::size_t i = 0; i < n; ++i) x[i] = wide(gen);
+    vector_exp(&x[0], &y[0], n);
+    for (std::size_t i = 0; i < n; ++i) exp_ulp = std::max(exp_ulp, ulp_error(y[i], expl(static_cast<long double>(x[i]))));
+    for (std::size_t i = 0; i < n; ++i) x[i] = std::exp(0.98 * wide(gen));
+    vector_log(&x[0], &y[0], n);
+    for (std::size_t i = 0; i < n; ++i) log_ulp = std::max(log_ulp, ulp_error(y[i], logl(static_cast<long double>(x[i]))));
+
+    //débit sur une ligne de grille en log-prix (N = 1000)
+    std::vector<double> row(1001);
+    for (std::size_t i = 0; i < row.size(); ++i) row[i] = grid(gen);
+    double exp_ns, exp_std_ns, log_ns, log_std_ns;
+    time_kernel(vector_exp, std_exp, row, exp_ns, exp_std_ns);
+    for (std::size_t i = 0; i < row.size(); ++i) row[i] = std::exp(row[i]);
+    time_kernel(vector_log, std_log, row, log_ns, log_std_ns);
+
+    std::cout << std::setw(8) << "noyau" << std::setw(14) << "ULP max" << std::setw(16) << "ns / valeur"
+              << std::setw(16) << "std (ns)" << std::endl;
+    std::cout << std::setw(8) << "exp" << std::setw(14) << exp_ulp << std::setw(16) << exp_ns << std::setw(16) << exp_std_ns << std::endl;
+    std::cout << std::setw(8) << "log" << std::setw(14) << log_ulp << std::setw(16) << log_ns << std::setw(16) << log_std_ns << std::endl;
+
+    //solveur implicite : les changements de variable passent par vector_exp et un facteur par ligne
+    Call call(100.0, 400.0, 0.05, 1.0);
+    EDP edp(&call, 0.2, 0.05, 1.0, 400.0);
+    Implicite_solver solver(edp, 2000, 1000);
+    solver.solve();
+    const int repeats = 10;
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    for (int k = 0; k < repeats; ++k) solver.solve();
+    double ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count() / repeats;
+    std::cout << "Implicite_solver 2000 x 1000 : " << ms << " ms, prix au strike " << solver.get_value_at_S(100.0, 0) << std::endl;
+    return 0;
+}
@@ -0,0 +1,97 @@
+/**
+ * @file bench_term_structure.cpp
+ * @author Mathias LE BOUEDEC - Lilou MALFOY
+ * @date 2025
+ * @brief Structure par terme de r et sigma : précision et coût par rapport à une résolution à paramètres constants
+ *
+ * Un prix européen avec r(t) et sigma(t) est celui de Black-Scholes avec le taux moyen et la volatilité
+ * quadratique moyenne : la formule fermée sert de référence.
+ *
+ * Compilation : g++ -O2 -pthread bench_term_structure.cpp term_structure.cpp solver.cpp simd_math.cpp domain.cpp time_stepping.cpp
+ *               workspace.cpp edp.cpp payoff.cpp analytic.cpp -o bench_term_structure
+ */
+
+#include <iostream>
+#include <iomanip>
+#include <string>
+#include <vector>
+#include <chrono>
+#include "payoff.hpp"
+#include "edp.hpp"
+#include "solver.hpp"
+#include "analytic.hpp"
+
+/**
+ * @brief Résout plusieurs fois et renvoie le prix au strike et le temps moyen
+ * @param name Nom de la ligne
+ * @param solver Solveur prêt
+ * @param is_cn true pour Crank-Nicolson (ligne 0 sur une grille uniforme en S)
+ * @param S0 Spot
+ * @param reference Prix de référence
+ */
+static void report(const std::string& name, Solver& solver, bool is_cn, double S0, double reference) {
+    const int repeats = 20;
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    for (int k = 0; k < repeats; ++k) solver.solve();
+    double ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count() / repeats;
+
+    double price;
+    if (is_cn) {
+        std::vector<double> grid = solver.get_grid();
+        const std::vector<double>& v = solver.get_surface()[0];
+        double x = (S0 - grid[0]) / (grid[1] - grid[0]);
+        int i = static_cast<int>(x);
+        price = v[i] + (x - i) * (v[i + 1] - v[i]);
+    } else {
+        price = static_cast<Implicite_solver&>(solver).get_value_at_S(S0, 0);
+    }
+    std::cout << std::setw(24) << name << std::setw(14) << price << std::setw(14) << price - reference
+              << std::setw(12) << ms << std::endl;
+}
+
+int main() {
+    double K = 100.0, L = 400.0, T = 2.0, S0 = 100.0;
+    int N = 800, M = 400;
+
+    //taux et volatilité trimestriels, dates décalées : 14 morceaux au total
+    std::vector<double> r_dates, r_values(1, 0.01), v_dates, v_values(1, 0.30);
+    for (int q = 1; q < 8; ++q) {
+        r_dates.push_back(0.25 * q);
+        r_values.push_back(0.01 + 0.005 * q);
+        v_dates.push_back(0.25 * q - 0.1);
+        v_values.push_back(0.30 - 0.015 * q);
+    }
+    Piecewise_curve rate(r_dates, r_values), vol(v_dates, v_values);
+
+    Call call(K, L, 0.0, T);
+    EDP edp(&call, 0.0, 0.0, T, L);
+    edp.set_term_structure(rate, vol);
+    double r_eq = edp.getR(), sigma_eq = edp.getSigma();
+    double reference = black_scholes_call(S0, K, r_eq, sigma_eq, T);
+    std::cout << "r moyen = " << r_eq << ", sigma quadratique moyenne = " << sigma_eq
+              << ", Black-Scholes = " << reference << " (" << edp.breakpoints().size() << " dates de changement)" << std::endl;
+
+    Call call_flat(K, L, r_eq, T);
+    EDP edp_flat(&call_flat, sigma_eq, r_eq, T, L);
+
+    std::cout << std::setw(24) << "résolution" << std::setw(14) << "prix" << std::setw(14) << "écart"
+              << std::setw(12) << "temps (ms)" << std::endl;
+    Cranck_nicolson cn_flat(edp_flat, N, M);
+    cn_flat.set_time_scheme(SCHEME_RANNACHER);
+    report("CN constant", cn_flat, true, S0, reference);
+
+    Cranck_nicolson cn(edp, N, M);
+    cn.set_time_scheme(SCHEME_RANNACHER);
+    report("CN structure par terme", cn, true, S0, reference);
+
+    Cranck_nicolson cn_odd(edp, N, M + 7);
+    cn_odd.set_time_scheme(SCHEME_RANNACHER);
+    report("CN, dates hors noeuds", cn_odd, true, S0, reference);
+
+    Implicite_solver imp_flat(edp_flat, N, M);
+    report("implicite constant", imp_flat, false, S0, reference);
+
+    Implicite_solver imp(edp, N, M);
+    report("implicite struct. terme", imp, false, S0, reference);
+    return 0;
+}
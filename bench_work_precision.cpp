@@ -0,0 +1,100 @@
+/**
+ * @file bench_work_precision.cpp
+ * @author Mathias LE BOUEDEC - Lilou MALFOY
+ * @date 2025
+ * @brief Tables travail-précision de tous les moteurs par rapport à la formule fermée
+ *
+ * Compilation : g++ -O2 -pthread bench_work_precision.cpp benchmark.cpp solver.cpp simd_math.cpp domain.cpp edp.cpp payoff.cpp term_structure.cpp
+ *               analytic.cpp cos_method.cpp montecarlo.cpp time_stepping.cpp workspace.cpp -o bench_work_precision
+ * Utilisation : ./bench_work_precision [préfixe des fichiers de sortie]
+ */
+
+#include <iostream>
+#include <iomanip>
+#include <fstream>
+#include <string>
+#include <vector>
+#include "payoff.hpp"
+#include "edp.hpp"
+#include "analytic.hpp"
+#include "benchmark.hpp"
+
+int main(int argc, char** argv) {
+    std::string prefix = (argc > 1) ? argv[1] : "work_precision";
+
+    double K = 100.0;
+    double L = 300.0;
+    double sigma = 0.1;
+    double r = 0.1;
+    double T = 1.0;
+
+    Option* call = new Call(K, L, r, T);
+    EDP edp(call, sigma, r, T, L);
+
+    // Spots où l'erreur est mesurée : [K/2, 3K/2], le strike en position centrale
+    std::vector<double> spots;
+    for (int k = 0; k <= 20; ++k) spots.push_back(0.5 * K + k * 0.05 * K);
+    int strike_index = 10;
+
+    // Référence de haute précision : formule fermée
+    std::vector<double> reference(spots.size());
+    for (std::size_t k = 0; k < spots.size(); ++k) reference[k] = black_scholes_price(edp, spots[k]);
+
+    std::vector<int> grids;
+    for (int N = 50; N <= 1600; N *= 2) grids.push_back(N);
+    std::vector<int> terms;
+    for (int N = 16; N <= 128; N *= 2) terms.push_back(N);
+    std::vector<int> paths;
+    for (int N = 10; N <= 640; N *= 4) paths.push_back(N);
+
+    std::vector< std::vector<Work_precision_point> > runs;
+    runs.push_back(sweep("cranck_nicolson", engine_cranck_nicolson, edp, grids, 1.0, spots, reference, strike_index));
+    runs.push_back(sweep("cranck_nicolson_smooth", engine_cranck_nicolson_smooth, edp, grids, 1.0, spots, reference, strike_index));
+    runs.push_back(sweep("tr_bdf2_M=N/4", engine_tr_bdf2, edp, grids, 0.25, spots, reference, strike_index));
+    runs.push_back(sweep("adaptive_tr_bdf2", engine_adaptive, edp, grids, 0.05, spots, reference, strike_index));
+    runs.push_back(sweep("implicite", engine_implicite, edp, grids, 1.0, spots, reference, strike_index));
+    runs.push_back(sweep("cos", engine_cos, edp, terms, 0.0, spots, reference, strike_index));
+    runs.push_back(sweep("monte_carlo", engine_monte_carlo, edp, paths, 0.0, spots, reference, strike_index, 1));
+
+    std::vector<Work_precision_point> all;
+    std::vector<Convergence_fit> fits;
+    for (std::size_t e = 0; e < runs.size(); ++e) {
+        all.insert(all.end(), runs[e].begin(), runs[e].end());
+        fits.push_back(fit_convergence(runs[e]));
+    }
+
+    std::cout << std::setw(24) << "moteur" << std::setw(7) << "N" << std::setw(7) << "M" << std::setw(14) << "temps (ms)"
+              << std::setw(14) << "err max" << std::setw(14) << "err strike" << std::endl;
+    for (std::size_t k = 0; k < all.size(); ++k) {
+        std::cout << std::setw(24) << all[k].engine << std::setw(7) << all[k].N << std::setw(7) << all[k].M
+                  << std::setw(14) << all[k].time_ms << std::setw(14) << all[k].max_error
+                  << std::setw(14) << all[k].strike_error << std::endl;
+    }
+
+    std::cout << std::endl << "Ordres observés (en N, au strike, en temps de calcul) :" << std::endl;
+    for (std::size_t k = 0; k < fits.size(); ++k) {
+        std::cout << std::setw(24) << fits[k].engine << std::setw(10) << fits[k].order_max
+                  << std::setw(10) << fits[k].order_strike << std::setw(10) << fits[k].order_time << std::endl;
+    }
+
+    std::cout << std::endl << "Configuration la moins coûteuse par précision visée :" << std::endl;
+    double tolerances[] = {1e-2, 1e-3, 1e-4, 1e-5};
+    for (int k = 0; k < 4; ++k) {
+        Work_precision_point best;
+        std::cout << std::setw(10) << tolerances[k] << " : ";
+        if (cheapest_for_tolerance(all, tolerances[k], best)) {
+            std::cout << best.engine << " N=" << best.N << " M=" << best.M << " (" << best.time_ms << " ms)" << std::endl;
+        } else {
+            std::cout << "aucune" << std::endl;
+        }
+    }
+
+    std::ofstream csv((prefix + ".csv").c_str());
+    write_csv(csv, all);
+    std::ofstream json((prefix + ".json").c_str());
+    write_json(json, all, fits);
+    std::cout << std::endl << "Résultats écrits dans " << prefix << ".csv et " << prefix << ".json" << std::endl;
+
+    delete call;
+    return 0;
+}
@@ -0,0 +1,71 @@
+/**
+ * @file bench_workspace.cpp
+ * @author Mathias LE BOUEDEC - Lilou MALFOY
+ * @date 2025
+ * @brief Boucle de portefeuille : recyclage de la mémoire des solveurs par le pool de travail
+ *
+ * Compilation : g++ -O2 -pthread bench_workspace.cpp workspace.cpp solver.cpp simd_math.cpp domain.cpp time_stepping.cpp edp.cpp payoff.cpp term_structure.cpp analytic.cpp -o bench_workspace
+ */
+
+#include <iostream>
+#include <vector>
+#include <chrono>
+#include <thread>
+#include "payoff.hpp"
+#include "edp.hpp"
+#include "solver.hpp"
+#include "workspace.hpp"
+
+/**
+ * @brief Résout un portefeuille de calls de strikes différents
+ * @param n_options Nombre d'options
+ * @param recycle false pour vider le pool à chaque option (allocation systématique)
+ * @return Somme des prix (évite que le calcul soit éliminé)
+ */
+static double price_portfolio(int n_options, bool recycle) {
+    double L = 300.0, sigma = 0.2, r = 0.05, T = 1.0;
+    int N = 200, M = 50;
+    double sum = 0.0;
+    for (int k = 0; k < n_options; ++k) {
+        if (!recycle) Workspace_pool::local().clear();
+        Call call(80.0 + 40.0 * k / n_options, L, r, T);
+        EDP edp(&call, sigma, r, T, L);
+        Cranck_nicolson solver(edp, N, M);
+        solver.solve();
+        sum += solver.get_results()[0][N / 3];
+    }
+    return sum;
+}
+
+int main() {
+    int n_options = 500;
+    int n_threads = 4;
+    bool modes[] = {false, true};
+
+    for (int m = 0; m < 2; ++m) {
+        std::vector<std::thread> workers;
+        std::vector<double> sums(n_threads);
+        std::vector<Workspace_stats> stats(n_threads);
+        std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+        for (int id = 0; id < n_threads; ++id) {
+            workers.push_back(std::thread([id, n_options, m, &modes, &sums, &stats]() {
+                Workspace_pool::local().clear();
+                Workspace_pool::local().reset_stats();
+                sums[id] = price_portfolio(n_options, modes[m]);
+                stats[id] = Workspace_pool::local().stats();
+            }));
+        }
+        for (int id = 0; id < n_threads; ++id) workers[id].join();
+        double ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+
+        unsigned long long allocated = 0, reused = 0;
+        for (int id = 0; id < n_threads; ++id) {
+            allocated += stats[id].bytes_allocated;
+            reused += stats[id].bytes_reused;
+        }
+        std::cout << (modes[m] ? "pool recyclé  " : "sans recyclage") << " : " << ms << " ms, "
+                  << allocated / (1024.0 * 1024.0) << " Mo alloués, "
+                  << reused / (1024.0 * 1024.0) << " Mo réutilisés (somme " << sums[0] << ")" << std::endl;
+    }
+    return 0;
+}
@@ -0,0 +1,305 @@
+/**
+ * @file benchmark.cpp
+ * @author Mathias LE BOUEDEC - Lilou MALFOY
+ * @date 2025
+ * @brief Implémentation du banc d'essai travail-précision
+ */
+
+#include "benchmark.hpp"
+#include "solver.hpp"
+#include "cos_method.hpp"
+#include "montecarlo.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <limits>
+#include <map>
+
+
+/**
+ * @brief Interpolation linéaire sur une grille croissante (pas forcément uniforme)
+ * @param grid Abscisses croissantes
+ * @param values Valeurs aux abscisses
+ * @param x Point d'évaluation
+ * @return Valeur interpolée (constante hors de la grille)
+ */
+double interpolate(const std::vector<double>& grid, const std::vector<double>& values, double x) {
+    if (x <= grid.front()) return values.front();
+    if (x >= grid.back()) return values.back();
+    std::size_t i = std::upper_bound(grid.begin(), grid.end(), x) - grid.begin() - 1;
+    double w = (x - grid[i]) / (grid[i + 1] - grid[i]);
+    return values[i] + w * (values[i + 1] - values[i]);
+}
+
+/**
+ * @brief Réglages d'un solveur Crank-Nicolson avant solve()
+ * @param solver Solveur à configurer
+ * @param N Nombre de points en espace
+ */
+typedef void (*Cranck_nicolson_setup)(Cranck_nicolson& solver, int N);
+
+/**
+ * @brief Résout avec Cranck_nicolson et interpole la ligne t=0 aux spots
+ * @param edp EDP à résoudre
+ * @param N Nombre de points en espace
+ * @param M Nombre de pas de temps
+ * @param spots Spots demandés
+ * @param setup Réglages du solveur (nullptr : Crank-Nicolson par défaut)
+ * @return Prix aux spots
+ */
+static std::vector<double> run_cranck_nicolson(EDP& edp, int N, int M, const std::vector<double>& spots,
+                                               Cranck_nicolson_setup setup) {
+    Cranck_nicolson solver(edp, N, M);
+    if (setup != nullptr) setup(solver, N);
+    solver.solve();
+    std::vector<double> grid = solver.get_grid();
+    std::vector<double> v = solver.get_results()[0];
+    std::vector<double> prices(spots.size());
+    for (std::size_t k = 0; k < spots.size(); ++k) prices[k] = interpolate(grid, v, spots[k]);
+    return prices;
+}
+
+/**
+ * @brief Strike sur un noeud et payoff lissé
+ */
+static void setup_smooth(Cranck_nicolson& solver, int /*N*/) {
+    solver.set_grid_alignment(ALIGN_NODE);
+    solver.set_payoff_smoothing(true);
+}
+
+/**
+ * @brief Lissage et schéma en temps TR-BDF2
+ */
+static void setup_tr_bdf2(Cranck_nicolson& solver, int N) {
+    setup_smooth(solver, N);
+    solver.set_time_scheme(SCHEME_TR_BDF2);
+}
+
+/**
+ * @brief Lissage, TR-BDF2 et pas adaptatif de tolérance 25/N^2
+ */
+static void setup_adaptive(Cranck_nicolson& solver, int N) {
+    setup_tr_bdf2(solver, N);
+    solver.set_adaptive(25.0 / (static_cast<double>(N) * N)); //même ordre que l'erreur en espace
+}
+
+/**
+ * @brief Moteur Crank-Nicolson sur grille uniforme
+ */
+std::vector<double> engine_cranck_nicolson(EDP& edp, int N, int M, const std::vector<double>& spots) {
+    return run_cranck_nicolson(edp, N, M, spots, nullptr);
+}
+
+/**
+ * @brief Moteur Crank-Nicolson avec strike sur un noeud et payoff lissé
+ */
+std::vector<double> engine_cranck_nicolson_smooth(EDP& edp, int N, int M, const std::vector<double>& spots) {
+    return run_cranck_nicolson(edp, N, M, spots, setup_smooth);
+}
+
+/**
+ * @brief Moteur Crank-Nicolson lissé avec schéma en temps TR-BDF2 (L-stable, ordre 2)
+ */
+std::vector<double> engine_tr_bdf2(EDP& edp, int N, int M, const std::vector<double>& spots) {
+    return run_cranck_nicolson(edp, N, M, spots, setup_tr_bdf2);
+}
+
+/**
+ * @brief Moteur Crank-Nicolson lissé avec pas adaptatif TR-BDF2, tolérance en 1/N^2 (M donne le pas initial)
+ */
+std::vector<double> engine_adaptive(EDP& edp, int N, int M, const std::vector<double>& spots) {
+    return run_cranck_nicolson(edp, N, M, spots, setup_adaptive);
+}
+
+/**
+ * @brief Moteur implicite sur l'EDP réduite
+ */
+std::vector<double> engine_implicite(EDP& edp, int N, int M, const std::vector<double>& spots) {
+    Implicite_solver solver(edp, N, M);
+    solver.solve();
+    std::vector<double> prices(spots.size());
+    for (std::size_t k = 0; k < spots.size(); ++k) prices[k] = solver.get_value_at_S(spots[k], 0);
+    return prices;
+}
+
+/**
+ * @brief Moteur COS (N termes, M ignoré)
+ */
+std::vector<double> engine_cos(EDP& edp, int N, int /*M*/, const std::vector<double>& spots) {
+    Cos_pricer pricer(edp, N);
+    bool call = dynamic_cast<const Call*>(edp.getOption()) != nullptr;
+    std::vector<double> strike(1, edp.getOption()->getK());
+    std::vector<double> prices(spots.size());
+    for (std::size_t k = 0; k < spots.size(); ++k) prices[k] = pricer.price_strikes(spots[k], strike, call)[0];
+    return prices;
+}
+
+/**
+ * @brief Moteur Monte-Carlo (1000 * N trajectoires antithétiques, M pas)
+ */
+std::vector<double> engine_monte_carlo(EDP& edp, int N, int M, const std::vector<double>& spots) {
+    Monte_carlo mc(edp, 1000L * N, M);
+    mc.set_antithetic(true);
+    std::vector<double> prices(spots.size());
+    for (std::size_t k = 0; k < spots.size(); ++k) prices[k] = mc.price(spots[k]).price;
+    return prices;
+}
+
+/**
+ * @brief Balaye les tailles de grille d'un moteur et mesure temps et erreurs
+ * @param name Nom du moteur
+ * @param engine Moteur évalué
+ * @param edp EDP à résoudre
+ * @param Ns Tailles de grille en espace
+ * @param M_ratio Rapport M / N
+ * @param spots Spots où l'erreur est mesurée
+ * @param reference Prix de référence aux spots
+ * @param strike_index Indice du spot égal au strike dans spots
+ * @param repeats Nombre de répétitions (on garde le meilleur temps)
+ * @return Points travail-précision
+ */
+std::vector<Work_precision_point> sweep(const std::string& name, Pricing_engine engine, EDP& edp,
+                                        const std::vector<int>& Ns, double M_ratio,
+                                        const std::vector<double>& spots, const std::vector<double>& reference,
+                                        int strike_index, int repeats) {
+    std::vector<Work_precision_point> points;
+    for (std::size_t n = 0; n < Ns.size(); ++n) {
+        Work_precision_point p;
+        p.engine = name;
+        p.N = Ns[n];
+        p.M = std::max(1, static_cast<int>(M_ratio * Ns[n] + 0.5));
+        p.time_ms = std::numeric_limits<double>::infinity();
+
+        std::vector<double> prices;
+        for (int rep = 0; rep < std::max(repeats, 1); ++rep) {
+            std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+            prices = engine(edp, p.N, p.M, spots);
+            double ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+            p.time_ms = std::min(p.time_ms, ms);
+        }
+
+        p.max_error = 0.0;
+        for (std::size_t k = 0; k < spots.size(); ++k) {
+            p.max_error = std::max(p.max_error, std::abs(prices[k] - reference[k]));
+        }
+        p.strike_error = std::abs(prices[strike_index] - reference[strike_index]);
+        points.push_back(p);
+    }
+    return points;
+}
+
+/**
+ * @brief Pente de la droite des moindres carrés de log(y) en fonction de log(x)
+ * @param x Abscisses (strictement positives)
+ * @param y Ordonnées (les valeurs nulles sont ignorées)
+ * @return Pente, 0 s'il y a moins de deux points exploitables
+ */
+static double log_log_slope(const std::vector<double>& x, const std::vector<double>& y) {
+    double sx = 0.0, sy = 0.0, sxx = 0.0, sxy = 0.0;
+    int n = 0;
+    for (std::size_t k = 0; k < x.size(); ++k) {
+        if (x[k] <= 0.0 || y[k] <= 0.0) continue;
+        double lx = std::log(x[k]), ly = std::log(y[k]);
+        sx += lx; sy += ly; sxx += lx * lx; sxy += lx * ly;
+        ++n;
+    }
+    double denom = n * sxx - sx * sx;
+    if (n < 2 || std::abs(denom) < 1e-300) return 0.0;
+    return (n * sxy - sx * sy) / denom;
+}
+
+/**
+ * @brief Ajuste les ordres de convergence par moindres carrés en échelle log-log
+ * @param points Points d'un même moteur
+ * @return Ordres observés
+ */
+Convergence_fit fit_convergence(const std::vector<Work_precision_point>& points) {
+    std::vector<double> n, t, e_max, e_strike;
+    for (std::size_t k = 0; k < points.size(); ++k) {
+        n.push_back(points[k].N);
+        t.push_back(points[k].time_ms);
+        e_max.push_back(points[k].max_error);
+        e_strike.push_back(points[k].strike_error);
+    }
+    Convergence_fit fit;
+    fit.engine = points.empty() ? std::string() : points[0].engine;
+    fit.order_max = -log_log_slope(n, e_max);
+    fit.order_strike = -log_log_slope(n, e_strike);
+    fit.order_time = -log_log_slope(t, e_max);
+    return fit;
+}
+
+/**
+ * @brief Configuration la moins coûteuse atteignant une précision cible
+ * @param points Points de tous les moteurs
+ * @param tolerance Erreur max visée
+ * @param best Point retenu
+ * @return false si aucune configuration n'atteint la précision
+ */
+bool cheapest_for_tolerance(const std::vector<Work_precision_point>& points, double tolerance, Work_precision_point& best) {
+    bool found = false;
+    for (std::size_t k = 0; k < points.size(); ++k) {
+        if (points[k].max_error > tolerance) continue;
+        if (!found || points[k].time_ms < best.time_ms) {
+            best = points[k];
+            found = true;
+        }
+    }
+    return found;
+}
+
+/**
+ * @brief Écrit les points au format CSV
+ * @param os Flux de sortie
+ * @param points Points travail-précision
+ */
+void write_csv(std::ostream& os, const std::vector<Work_precision_point>& points) {
+    os << "engine,N,M,time_ms,max_error,strike_error\n";
+    for (std::size_t k = 0; k < points.size(); ++k) {
+        const Work_precision_point& p = points[k];
+        os << p.engine << ',' << p.N << ',' << p.M << ',' << p.time_ms << ','
+           << p.max_error << ',' << p.strike_error << '\n';
+    }
+}
+
+/**
+ * @brief Écrit un nombre JSON : null pour NaN et les infinis (moteur divergent), que JSON n'accepte pas
+ * @param os Flux de sortie
+ * @param x Valeur
+ */
+static void write_json_number(std::ostream& os, double x) {
+    if (std::isfinite(x)) os << x;
+    else os << "null";
+}
+
+/**
+ * @brief Écrit les points et les ordres observés au format JSON (null pour une valeur non finie)
+ * @param os Flux de sortie
+ * @param points Points travail-précision
+ * @param fits Ordres de convergence par moteur
+ */
+void write_json(std::ostream& os, const std::vector<Work_precision_point>& points, const std::vector<Convergence_fit>& fits) {
+    os << "{\n  \"points\": [\n";
+    for (std::size_t k = 0; k < points.size(); ++k) {
+        const Work_precision_point& p = points[k];
+        os << "    {\"engine\": \"" << p.engine << "\", \"N\": " << p.N << ", \"M\": " << p.M << ", \"time_ms\": ";
+        write_json_number(os, p.time_ms);
+        os << ", \"max_error\": ";
+        write_json_number(os, p.max_error);
+        os << ", \"strike_error\": ";
+        write_json_number(os, p.strike_error);
+        os << "}" << (k + 1 < points.size() ? "," : "") << "\n";
+    }
+    os << "  ],\n  \"fits\": [\n";
+    for (std::size_t k = 0; k < fits.size(); ++k) {
+        const Convergence_fit& f = fits[k];
+        os << "    {\"engine\": \"" << f.engine << "\", \"order_max\": ";
+        write_json_number(os, f.order_max);
+        os << ", \"order_strike\": ";
+        write_json_number(os, f.order_strike);
+        os << ", \"order_time\": ";
+        write_json_number(os, f.order_time);
+        os << "}" << (k + 1 < fits.size() ? "," : "") << "\n";
+    }
+    os << "  ]\n}\n";
+}
@@ -0,0 +1,146 @@
+/**
+ * @file benchmark.hpp
+ * @author Mathias LE BOUEDEC - Lilou MALFOY
+ * @date 2025
+ * @brief Banc d'essai travail-précision : balayage des grilles, ordres de convergence, export CSV/JSON
+ */
+
+#ifndef BENCHMARK_HPP
+#define BENCHMARK_HPP
+
+#include "edp.hpp"
+#include <ostream>
+#include <string>
+#include <vector>
+
+
+/**
+ * @brief Moteur de pricing évalué par le banc : prix à t=0 aux spots demandés
+ * @param edp EDP à résoudre
+ * @param N Paramètre de résolution (points en espace, termes COS, milliers de trajectoires)
+ * @param M Nombre de pas de temps
+ * @param spots Prix de l'actif où l'on veut le prix
+ * @return Prix de l'option pour chaque spot
+ */
+typedef std::vector<double> (*Pricing_engine)(EDP& edp, int N, int M, const std::vector<double>& spots);
+
+
+/**
+ * @brief Un point de la courbe travail-précision
+ */
+struct Work_precision_point {
+    std::string engine;  // nom du moteur
+    int N;               // paramètre de résolution en espace
+    int M;               // nombre de pas de temps
+    double time_ms;      // temps de calcul (meilleur des répétitions)
+    double max_error;    // erreur max sur les spots demandés
+    double strike_error; // erreur au strike
+};
+
+
+/**
+ * @brief Ordres de convergence observés d'un moteur
+ */
+struct Convergence_fit {
+    std::string engine;  // nom du moteur
+    double order_max;    // ordre observé de l'erreur max en fonction de N
+    double order_strike; // ordre observé de l'erreur au strike en fonction de N
+    double order_time;   // pente de l'erreur max en fonction du temps de calcul
+};
+
+
+/**
+ * @brief Interpolation linéaire sur une grille croissante (pas forcément uniforme)
+ * @param grid Abscisses croissantes
+ * @param values Valeurs aux abscisses
+ * @param x Point d'évaluation
+ * @return Valeur interpolée (constante hors de la grille)
+ */
+double interpolate(const std::vector<double>& grid, const std::vector<double>& values, double x);
+
+/**
+ * @brief Moteur Crank-Nicolson sur grille uniforme
+ */
+std::vector<double> engine_cranck_nicolson(EDP& edp, int N, int M, const std::vector<double>& spots);
+
+/**
+ * @brief Moteur Crank-Nicolson avec strike sur un noeud et payoff lissé
+ */
+std::vector<double> engine_cranck_nicolson_smooth(EDP& edp, int N, int M, const std::vector<double>& spots);
+
+/**
+ * @brief Moteur Crank-Nicolson lissé avec schéma en temps TR-BDF2 (L-stable, ordre 2)
+ */
+std::vector<double> engine_tr_bdf2(EDP& edp, int N, int M, const std::vector<double>& spots);
+
+/**
+ * @brief Moteur Crank-Nicolson lissé avec pas adaptatif TR-BDF2, tolérance en 1/N^2 (M donne le pas initial)
+ */
+std::vector<double> engine_adaptive(EDP& edp, int N, int M, const std::vector<double>& spots);
+
+/**
+ * @brief Moteur implicite sur l'EDP réduite
+ */
+std::vector<double> engine_implicite(EDP& edp, int N, int M, const std::vector<double>& spots);
+
+/**
+ * @brief Moteur COS (N termes, M ignoré)
+ */
+std::vector<double> engine_cos(EDP& edp, int N, int M, const std::vector<double>& spots);
+
+/**
+ * @brief Moteur Monte-Carlo (1000 * N trajectoires antithétiques, M pas)
+ */
+std::vector<double> engine_monte_carlo(EDP& edp, int N, int M, const std::vector<double>& spots);
+
+/**
+ * @brief Balaye les tailles de grille d'un moteur et mesure temps et erreurs
+ * @param name Nom du moteur
+ * @param engine Moteur évalué
+ * @param edp EDP à résoudre
+ * @param Ns Tailles de grille en espace
+ * @param M_ratio Rapport M / N
+ * @param spots Spots où l'erreur est mesurée
+ * @param reference Prix de référence aux spots
+ * @param strike_index Indice du spot égal au strike dans spots
+ * @param repeats Nombre de répétitions (on garde le meilleur temps)
+ * @return Points travail-précision
+ */
+std::vector<Work_precision_point> sweep(const std::string& name, Pricing_engine engine, EDP& edp,
+                                        const std::vector<int>& Ns, double M_ratio,
+                                        const std::vector<double>& spots, const std::vector<double>& reference,
+                                        int strike_index, int repeats = 3);
+
+/**
+ * @brief Ajuste les ordres de convergence par moindres carrés en échelle log-log
+ * @param points Points d'un même moteur
+ * @return Ordres observés
+ */
+Convergence_fit fit_convergence(const std::vector<Work_precision_point>& points);
+
+/**
+ * @brief Configuration la moins coûteuse atteignant une précision cible
+ * @param points Points de tous les moteurs
+ * @param tolerance Erreur max visée
+ * @param best Point retenu
+ * @return false si aucune configuration n'atteint la précision
+ */
+bool cheapest_for_tolerance(const std::vector<Work_precision_point>& points, double tolerance, Work_precision_point& best);
+
+/**
+ * @brief Écrit les points au format CSV
+ * @param os Flux de sortie
+ * @param points Points travail-précision
+ */
+void write_csv(std::ostream& os, const std::vector<Work_precision_point>& points);
+
+/**
+ * @brief Écrit les points et les ordres observés au format JSON (null pour une valeur non finie)
+ * @param os Flux de sortie
+ * @param points Points travail-précision
+ * @param fits Ordres de convergence par moteur
+ */
+void write_json(std::ostream& os, const std::vector<Work_precision_point>& points, const std::vector<Convergence_fit>& fits);
+
+
+#endif // BENCHMARK_HPP
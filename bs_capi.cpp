@@ -0,0 +1,206 @@
+/**
+ * @file bs_capi.cpp
+ * @author Mathias LE BOUEDEC - Lilou MALFOY
+ * @date 2025
+ * @brief Implémentation de l'interface C : une résolution Crank-Nicolson par option, mémoire du pool du thread
+ */
+
+#include "bs_capi.h"
+#include "payoff.hpp"
+#include "edp.hpp"
+#include "solver.hpp"
+#include "workspace.hpp"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+
+namespace {
+
+/**
+ * @brief Vérifie qu'une valeur est finie et strictement positive
+ * @param x Valeur
+ * @return true si 0 < x < infini
+ */
+bool positive(double x) {
+    return x > 0.0 && x <= std::numeric_limits<double>::max();
+}
+
+/**
+ * @brief Sensibilités adjointes du thread : dlow et dhigh gardent leur mémoire d'une option à l'autre
+ * @return Structure locale au thread
+ */
+Adjoint_sensitivities& thread_sensitivities() {
+    static thread_local Adjoint_sensitivities sens;
+    return sens;
+}
+
+/**
+ * @brief Sorties d'une option, écrites seulement si le tableau correspondant est fourni
+ */
+struct Outputs {
+    double price, delta, gamma, theta, vega, rho;
+};
+
+/**
+ * @brief Résout une option et calcule ses sorties
+ * @param is_call Call ou put
+ * @param K Strike
+ * @param sigma Volatilité
+ * @param r Taux sans risque
+ * @param T Maturité
+ * @param spot Prix de l'actif
+ * @param config Grille
+ * @param out Sorties
+ *
+ * L'option, l'EDP et le solveur sont sur la pile ; le solveur emprunte ses vecteurs au pool du thread,
+ * et les sensibilités adjointes réutilisent une structure locale au thread.
+ */
+void price_one(bool is_call, double K, double sigma, double r, double T, double spot,
+               const bs_grid_config& config, Outputs& out) {
+    const int N = config.N, M = config.M;
+    double L = config.domain_multiple * std::max(K, spot);
+    Call call(K, L, r, T);
+    Put put(K, L, r, T);
+    Option* option = is_call ? static_cast<Option*>(&call) : static_cast<Option*>(&put);
+    EDP edp(option, sigma, r, T, L);
+    Cranck_nicolson solver(edp, N, M);
+    solver.set_time_scheme(config.rannacher_steps > 0 ? SCHEME_RANNACHER : SCHEME_CRANK_NICOLSON, config.rannacher_steps);
+    solver.solve();
+
+    //parabole sur les noeuds i-1, i, i+1 (i le plus proche du spot) de la ligne t=0
+    const std::vector<double>& v = solver.get_surface()[0];
+    double dS = L / N;
+    int i = std::min(std::max(static_cast<int>(std::floor(spot / dS + 0.5)), 1), N - 1);
+    double x = spot / dS - i;
+    double d1 = 0.5 * (v[i + 1] - v[i - 1]);
+    double d2 = v[i + 1] - 2.0 * v[i] + v[i - 1];
+    out.price = v[i] + x * d1 + 0.5 * x * x * d2;
+    out.delta = (d1 + x * d2) / dS;
+    out.gamma = d2 / (dS * dS);
+    out.theta = r * out.price - r * spot * out.delta - 0.5 * sigma * sigma * spot * spot * out.gamma;
+
+    if (config.greeks & BS_GREEK_VEGA_RHO) {
+        Adjoint_sensitivities& sens = thread_sensitivities();
+        solver.adjoint(spot, sens);
+        out.vega = sens.dsigma;
+        out.rho = sens.dr;
+    } else {
+        out.vega = out.rho = std::numeric_limits<double>::quiet_NaN();
+    }
+}
+
+} // namespace
+
+
+/**
+ * @brief Version de l'interface de la bibliothèque chargée
+ * @return BS_CAPI_VERSION à la compilation de la bibliothèque
+ */
+int bs_abi_version(void) {
+    return BS_CAPI_VERSION;
+}
+
+/**
+ * @brief Remplit une configuration par défaut (N = 400, M = 100, domaine 4 max(K, spot), 2 pas de Rannacher)
+ * @param config Configuration à remplir
+ */
+void bs_default_grid(bs_grid_config* config) {
+    if (!config) return;
+    config->N = 400;
+    config->M = 100;
+    config->domain_multiple = 4.0;
+    config->rannacher_steps = 2;
+    config->greeks = 0;
+}
+
+/**
+ * @brief Message associé à un état
+ * @param status BS_OK, BS_ERR_ARGUMENT ou BS_ERR_SOLVER
+ * @return Chaîne statique
+ */
+const char* bs_status_message(int status) {
+    switch (status) {
+        case BS_OK: return "ok";
+        case BS_ERR_ARGUMENT: return "paramètre invalide (type, K, sigma, T ou spot)";
+        case BS_ERR_SOLVER: return "échec de la résolution";
+        default: return "état inconnu";
+    }
+}
+
+/**
+ * @brief Rend au système la mémoire de travail conservée par le thread appelant
+ */
+void bs_release_thread_cache(void) {
+    Workspace_pool::local().clear();
+    Adjoint_sensitivities& sens = thread_sensitivities();
+    std::vector<double>().swap(sens.dlow);
+    std::vector<double>().swap(sens.dhigh);
+}
+
+/**
+ * @brief Borne la mémoire de travail conservée par le thread appelant (64 Mo par défaut)
+ * @param max_bytes Nombre maximal d'octets conservés
+ */
+void bs_set_thread_cache_limit(size_t max_bytes) {
+    Workspace_pool::local().set_max_bytes(max_bytes);
+}
+
+/**
+ * @brief Prix et grecques à t=0 d'un lot d'options européennes (tableaux en structure de tableaux)
+ * @param n Nombre d'options
+ * @param type BS_CALL ou BS_PUT
+ * @param K Strikes
+ * @param sigma Volatilités
+ * @param r Taux sans risque
+ * @param T Maturités
+ * @param spot Prix de l'actif
+ * @param config Grille (NULL : bs_default_grid)
+ * @param price Prix (obligatoire)
+ * @param delta dV/dS (NULL si inutile)
+ * @param gamma d2V/dS2 (NULL si inutile)
+ * @param theta dV/dt (NULL si inutile)
+ * @param vega dV/dsigma (NULL si inutile ; NaN sans BS_GREEK_VEGA_RHO)
+ * @param rho dV/dr (NULL si inutile ; NaN sans BS_GREEK_VEGA_RHO)
+ * @param status État de chaque option (NULL si inutile) ; les sorties d'une option en erreur valent NaN
+ * @return Nombre d'options en erreur, ou -1 si un tableau obligatoire est NULL ou la configuration invalide
+ */
+int bs_price_batch(size_t n, const int* type, const double* K, const double* sigma, const double* r,
+                   const double* T, const double* spot, const bs_grid_config* config,
+                   double* price, double* delta, double* gamma, double* theta, double* vega, double* rho,
+                   int* status) {
+    if (n == 0) return 0;
+    if (!type || !K || !sigma || !r || !T || !spot || !price) return -1;
+    bs_grid_config grid;
+    if (config) grid = *config;
+    else bs_default_grid(&grid);
+    if (grid.N < 4 || grid.M < 2 || !(grid.domain_multiple > 1.0) || grid.rannacher_steps < 0) return -1;
+
+    const double nan = std::numeric_limits<double>::quiet_NaN();
+    int failed = 0;
+    for (size_t k = 0; k < n; ++k) {
+        Outputs out = {nan, nan, nan, nan, nan, nan};
+        int state = BS_OK;
+        if ((type[k] != BS_CALL && type[k] != BS_PUT) || !positive(K[k]) || !positive(sigma[k]) || !positive(T[k])
+            || !positive(spot[k]) || !(std::abs(r[k]) <= std::numeric_limits<double>::max())) {
+            state = BS_ERR_ARGUMENT;
+        } else {
+            try {
+                price_one(type[k] == BS_CALL, K[k], sigma[k], r[k], T[k], spot[k], grid, out);
+            } catch (...) {
+                //aucune exception ne doit traverser l'interface C
+                out.price = out.delta = out.gamma = out.theta = out.vega = out.rho = nan;
+                state = BS_ERR_SOLVER;
+            }
+        }
+        if (state != BS_OK) ++failed;
+        price[k] = out.price;
+        if (delta) delta[k] = out.delta;
+        if (gamma) gamma[k] = out.gamma;
+        if (theta) theta[k] = out.theta;
+        if (vega) vega[k] = out.vega;
+        if (rho) rho[k] = out.rho;
+        if (status) status[k] = state;
+    }
+    return failed;
+}
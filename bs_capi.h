@@ -0,0 +1,129 @@
+/**
+ * @file bs_capi.h
+ * @author Mathias LE BOUEDEC - Lilou MALFOY
+ * @date 2025
+ * @brief Interface C stable : pricing d'un lot d'options européennes sur des tableaux fournis par l'appelant
+ *
+ * En-tête C pur, utilisable depuis C, C++ ou tout langage doté d'une interface C (Python ctypes, Rust, Julia...).
+ * Bibliothèque partagée :
+ *   g++ -O2 -fPIC -shared -fvisibility=hidden -pthread bs_capi.cpp solver.cpp simd_math.cpp domain.cpp
+ *       time_stepping.cpp workspace.cpp edp.cpp payoff.cpp term_structure.cpp analytic.cpp -o libbs.so
+ */
+
+#ifndef BS_CAPI_H
+#define BS_CAPI_H
+
+#include <stddef.h>
+
+#if defined(_WIN32)
+#define BS_API __declspec(dllexport)
+#else
+#define BS_API __attribute__((visibility("default")))
+#endif
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** Version de l'interface : incrémentée à chaque changement incompatible des structures ou des signatures */
+#define BS_CAPI_VERSION 1
+
+/** Type d'option (tableau type) */
+#define BS_CALL 0
+#define BS_PUT 1
+
+/** État de chaque option (tableau status) */
+#define BS_OK 0              /* prix et grecques écrits */
+#define BS_ERR_ARGUMENT 1    /* type inconnu, K, sigma, T ou spot non strictement positifs, valeur non finie */
+#define BS_ERR_SOLVER 2      /* la résolution a échoué */
+
+/** Grecques facultatives (champ greeks de bs_grid_config) */
+#define BS_GREEK_VEGA_RHO 1  /* vega et rho par la passe adjointe (environ deux fois le coût du prix) */
+
+/**
+ * @brief Paramètres de la grille, communs à tout le lot
+ */
+typedef struct bs_grid_config {
+    int N;                  /* nombre de pas en S (>= 4) */
+    int M;                  /* nombre de pas de temps (>= 2) */
+    double domain_multiple; /* borne haute du domaine : domain_multiple * max(K, spot) (> 1) */
+    int rannacher_steps;    /* demi-pas implicites au démarrage de Crank-Nicolson (0 : Crank-Nicolson pur) */
+    int greeks;             /* combinaison de BS_GREEK_* */
+} bs_grid_config;
+
+/**
+ * @brief Version de l'interface de la bibliothèque chargée
+ * @return BS_CAPI_VERSION à la compilation de la bibliothèque
+ */
+BS_API int bs_abi_version(void);
+
+/**
+ * @brief Remplit une configuration par défaut (N = 400, M = 100, domaine 4 max(K, spot), 2 pas de Rannacher)
+ * @param config Configuration à remplir
+ */
+BS_API void bs_default_grid(bs_grid_config* config);
+
+/**
+ * @brief Message associé à un état
+ * @param status BS_OK, BS_ERR_ARGUMENT ou BS_ERR_SOLVER
+ * @return Chaîne statique
+ */
+BS_API const char* bs_status_message(int status);
+
+/**
+ * @brief Rend au système la mémoire de travail conservée par le thread appelant
+ *
+ * À appeler par un thread qui a fini ses lots (ou change durablement de taille de grille) ; le lot suivant
+ * sur ce thread réalloue ses tampons une fois.
+ */
+BS_API void bs_release_thread_cache(void);
+
+/**
+ * @brief Borne la mémoire de travail conservée par le thread appelant (64 Mo par défaut)
+ *
+ * Au-delà, les tampons les plus gros sont libérés en premier ; une grille dont la matrice dépasse
+ * la borne est réallouée à chaque option.
+ * @param max_bytes Nombre maximal d'octets conservés
+ */
+BS_API void bs_set_thread_cache_limit(size_t max_bytes);
+
+/**
+ * @brief Prix et grecques à t=0 d'un lot d'options européennes (tableaux en structure de tableaux)
+ *
+ * Chaque option est résolue par Crank-Nicolson sur une grille uniforme [0, domain_multiple max(K, spot)] ;
+ * le prix, delta et gamma viennent de la parabole passant par les trois noeuds les plus proches du spot,
+ * theta (par an, temps calendaire) de l'équation de Black-Scholes au spot : r V - r S delta - sigma^2 S^2 gamma / 2.
+ * Les grilles et tampons sont empruntés au pool de
+ * travail du thread appelant : après la première option d'une taille (N, M) sur un thread, aucune option
+ * n'alloue de mémoire. En contrepartie, chaque thread appelant conserve pour chaque taille (N, M) utilisée
+ * environ 8 (M + 1)(N + 1) octets de matrice et une trentaine de vecteurs de 8 (N + 1) octets
+ * (0,4 Mo pour la grille par défaut), dans la limite de 64 Mo par thread (bs_set_thread_cache_limit),
+ * jusqu'à bs_release_thread_cache ou la fin du thread. La fonction peut être appelée simultanément
+ * depuis plusieurs threads sur des tableaux de sortie distincts. Aucune exception ne traverse l'interface.
+ * @param n Nombre d'options
+ * @param type BS_CALL ou BS_PUT
+ * @param K Strikes
+ * @param sigma Volatilités
+ * @param r Taux sans risque
+ * @param T Maturités
+ * @param spot Prix de l'actif
+ * @param config Grille (NULL : bs_default_grid)
+ * @param price Prix (obligatoire)
+ * @param delta dV/dS (NULL si inutile)
+ * @param gamma d2V/dS2 (NULL si inutile)
+ * @param theta dV/dt (NULL si inutile)
+ * @param vega dV/dsigma (NULL si inutile ; NaN sans BS_GREEK_VEGA_RHO)
+ * @param rho dV/dr (NULL si inutile ; NaN sans BS_GREEK_VEGA_RHO)
+ * @param status État de chaque option (NULL si inutile) ; les sorties d'une option en erreur valent NaN
+ * @return Nombre d'options en erreur, ou -1 si un tableau obligatoire est NULL ou la configuration invalide
+ */
+BS_API int bs_price_batch(size_t n, const int* type, const double* K, const double* sigma, const double* r,
+                          const double* T, const double* spot, const bs_grid_config* config,
+                          double* price, double* delta, double* gamma, double* theta, double* vega, double* rho,
+                          int* status);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* BS_CAPI_H */
@@ -0,0 +1,323 @@
+/**
+ * @file compressed_surface.cpp
+ * @author Mathias LE BOUEDEC - Lilou MALFOY
+ * @date 2025
+ * @brief Implémentation du stockage compressé des surfaces
+ */
+
+#include "compressed_surface.hpp"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <limits>
+#include <stdexcept>
+
+
+/**
+ * @brief Arrondi d'un double dans un petit format flottant (signe, exp_bits bits d'exposant, man_bits bits de mantisse)
+ * @param x Valeur
+ * @param exp_bits Nombre de bits d'exposant
+ * @param man_bits Nombre de bits de mantisse
+ * @return Motif binaire sur 1 + exp_bits + man_bits bits
+ */
+static unsigned short encode_minifloat(double x, int exp_bits, int man_bits) {
+    const unsigned int sign = std::signbit(x) ? (1u << (exp_bits + man_bits)) : 0u;
+    const unsigned int exp_all = (1u << exp_bits) - 1;
+    const int bias = static_cast<int>(exp_all >> 1);
+    if (std::isnan(x)) return static_cast<unsigned short>(sign | (exp_all << man_bits) | (1u << (man_bits - 1)));
+
+    double a = std::fabs(x);
+    unsigned int bits;
+    if (a < std::ldexp(1.0, 1 - bias)) {
+        //sous-normal : pas fixe 2^(1 - bias - man_bits) ; un arrondi vers le haut donne le plus petit normal
+        bits = static_cast<unsigned int>(std::nearbyint(std::ldexp(a, man_bits + bias - 1)));
+    } else {
+        int e;
+        std::frexp(a, &e);
+        e -= 1; //a = 1.m x 2^e
+        unsigned int m = static_cast<unsigned int>(std::nearbyint(std::ldexp(a, man_bits - e)));
+        if (m == (2u << man_bits)) { //la mantisse arrondie déborde : puissance de 2 suivante
+            m >>= 1;
+            e += 1;
+        }
+        if (e > bias || std::isinf(a)) bits = exp_all << man_bits; //infini
+        else bits = (static_cast<unsigned int>(e + bias) << man_bits) | (m - (1u << man_bits));
+    }
+    return static_cast<unsigned short>(sign | bits);
+}
+
+/**
+ * @brief Valeur d'un motif binaire d'un petit format flottant
+ * @param h Motif binaire
+ * @param exp_bits Nombre de bits d'exposant
+ * @param man_bits Nombre de bits de mantisse
+ * @return Valeur
+ */
+static double decode_minifloat(unsigned short h, int exp_bits, int man_bits) {
+    const unsigned int exp_all = (1u << exp_bits) - 1;
+    const int bias = static_cast<int>(exp_all >> 1);
+    unsigned int e = (h >> man_bits) & exp_all;
+    unsigned long long m = h & ((1u << man_bits) - 1);
+    unsigned long long sign = static_cast<unsigned long long>((h >> (exp_bits + man_bits)) & 1u) << 63;
+    double value;
+    if (e == 0) {
+        value = static_cast<double>(m) * std::ldexp(1.0, 1 - bias - man_bits);
+        return sign ? -value : value;
+    }
+    //normal, infini ou NaN : exposant et mantisse recopiés dans les champs du double
+    unsigned long long exponent = (e == exp_all) ? 0x7FFULL : static_cast<unsigned long long>(static_cast<int>(e) - bias + 1023);
+    unsigned long long bits = sign | (exponent << 52) | (m << (52 - man_bits));
+    std::memcpy(&value, &bits, sizeof(double));
+    return value;
+}
+
+/**
+ * @brief Conversion d'un double en float16 IEEE (arrondi au plus proche, pair en cas d'égalité)
+ * @param x Valeur
+ * @return Motif binaire float16
+ */
+unsigned short to_float16(double x) {
+    return encode_minifloat(x, 5, 10);
+}
+
+/**
+ * @brief Conversion d'un float16 IEEE en double
+ * @param h Motif binaire float16
+ * @return Valeur
+ */
+double from_float16(unsigned short h) {
+    return decode_minifloat(h, 5, 10);
+}
+
+/**
+ * @brief Conversion d'un double en bfloat16 (arrondi au plus proche, pair en cas d'égalité)
+ * @param x Valeur
+ * @return Motif binaire bfloat16
+ */
+unsigned short to_bfloat16(double x) {
+    return encode_minifloat(x, 8, 7);
+}
+
+/**
+ * @brief Conversion d'un bfloat16 en double
+ * @param h Motif binaire bfloat16
+ * @return Valeur
+ */
+double from_bfloat16(unsigned short h) {
+    return decode_minifloat(h, 8, 7);
+}
+
+
+/**
+ * @brief Constructeur par défaut (surface vide)
+ */
+Compressed_surface::Compressed_surface()
+    : mode_(COMPRESS_QUANTIZED), rows_(0), cols_(0), step_(0.0), max_error_(0.0), offset_(1, 0) {}
+
+/**
+ * @brief Compresse une surface
+ * @param v Surface (lignes en temps, colonnes en S, toutes de même longueur)
+ * @param mode Format de compression
+ * @param max_error Erreur absolue maximale demandée (utilisée par COMPRESS_QUANTIZED)
+ * @throw std::invalid_argument si max_error <= 0 en mode quantifié, si les lignes n'ont pas la même
+ *        longueur ou si une valeur n'est pas finie en mode quantifié
+ */
+Compressed_surface::Compressed_surface(const std::vector< std::vector<double> >& v, Compression mode, double max_error)
+    : mode_(mode), rows_(v.size()), cols_(v.empty() ? 0 : v[0].size()), step_(0.0), max_error_(0.0) {
+    for (std::size_t j = 0; j < rows_; ++j) {
+        if (v[j].size() != cols_) throw std::invalid_argument("Compressed_surface : lignes de longueurs différentes");
+    }
+
+    if (mode_ != COMPRESS_QUANTIZED) {
+        half_.resize(rows_ * cols_);
+        for (std::size_t j = 0; j < rows_; ++j) {
+            for (std::size_t i = 0; i < cols_; ++i) {
+                unsigned short h = (mode_ == COMPRESS_FLOAT16) ? to_float16(v[j][i]) : to_bfloat16(v[j][i]);
+                double back = (mode_ == COMPRESS_FLOAT16) ? from_float16(h) : from_bfloat16(h);
+                half_[j * cols_ + i] = h;
+                //un NaN reste NaN ; un dépassement de la plage du format rend l'erreur infinie
+                if (!(std::isnan(v[j][i]) && std::isnan(back))) max_error_ = std::max(max_error_, std::fabs(back - v[j][i]));
+            }
+        }
+        offset_.assign(1, 0);
+        return;
+    }
+
+    if (!(max_error > 0.0)) throw std::invalid_argument("Compressed_surface : max_error doit être strictement positif");
+    double v_abs = 0.0;
+    for (std::size_t j = 0; j < rows_; ++j) {
+        for (std::size_t i = 0; i < cols_; ++i) {
+            if (!std::isfinite(v[j][i])) throw std::invalid_argument("Compressed_surface : valeur non finie");
+            v_abs = std::max(v_abs, std::fabs(v[j][i]));
+        }
+    }
+
+    //un arrondi au pas 2 max_error laisse une erreur d'au plus max_error, aux erreurs d'arrondi du produit près :
+    //l'erreur est mesurée et le pas réduit dans le cas limite où elle dépasse la demande
+    step_ = 2.0 * max_error;
+    std::vector<double> row;
+    while (true) {
+        if (v_abs / step_ > std::ldexp(1.0, 60)) throw std::invalid_argument("Compressed_surface : max_error trop petit pour les valeurs");
+        bytes_.clear();
+        offset_.assign(1, 0);
+        max_error_ = 0.0;
+        for (std::size_t j = 0; j < rows_; ++j) {
+            encode_quantized(v[j]);
+            decompress_row(j, row);
+            for (std::size_t i = 0; i < cols_; ++i) max_error_ = std::max(max_error_, std::fabs(row[i] - v[j][i]));
+        }
+        if (max_error_ <= max_error) break;
+        step_ *= 0.5;
+    }
+    std::vector<unsigned char>(bytes_).swap(bytes_); //rend la capacité en trop
+}
+
+/**
+ * @brief Compresse une ligne en mode COMPRESS_QUANTIZED
+ * @param row Ligne de la surface
+ */
+void Compressed_surface::encode_quantized(const std::vector<double>& row) {
+    long long q1 = 0, q2 = 0; //deux codes précédents
+    std::size_t zeros = 0;    //résidus nuls en attente
+    for (std::size_t i = 0; i <= cols_; ++i) {
+        long long d = 0;
+        if (i < cols_) {
+            long long q = std::llround(row[i] / step_);
+            long long predicted = (i == 0) ? 0 : (i == 1) ? q1 : 2 * q1 - q2; //extrapolation linéaire
+            d = q - predicted;
+            q2 = q1;
+            q1 = q;
+            if (d == 0) {
+                zeros++;
+                continue;
+            }
+        }
+        if (zeros > 0) {
+            put_varint(((zeros - 1) << 1) | 1); //série de résidus nuls : bit de poids faible à 1
+            zeros = 0;
+        }
+        if (i == cols_) break;
+
+        //zigzag (petits entiers signés -> petits entiers positifs), bit de poids faible à 0
+        unsigned long long z = (static_cast<unsigned long long>(d) << 1) ^ static_cast<unsigned long long>(d >> 63);
+        put_varint(z << 1);
+    }
+    offset_.push_back(bytes_.size());
+}
+
+/**
+ * @brief Ajoute un entier au flux, 7 bits par octet (bit de poids fort : octet suivant)
+ * @param z Entier positif
+ */
+void Compressed_surface::put_varint(unsigned long long z) {
+    while (z >= 0x80) {
+        bytes_.push_back(static_cast<unsigned char>(z | 0x80));
+        z >>= 7;
+    }
+    bytes_.push_back(static_cast<unsigned char>(z));
+}
+
+/**
+ * @brief Décompresse une ligne
+ * @param j Indice de la ligne
+ * @param out Vecteur qui reçoit les cols() valeurs
+ * @throw std::out_of_range si j est hors de la surface
+ */
+void Compressed_surface::decompress_row(std::size_t j, std::vector<double>& out) const {
+    if (j >= rows_) throw std::out_of_range("Compressed_surface : ligne hors de la surface");
+    out.resize(cols_);
+    if (cols_ == 0) return;
+
+    if (mode_ == COMPRESS_FLOAT16) {
+        for (std::size_t i = 0; i < cols_; ++i) out[i] = from_float16(half_[j * cols_ + i]);
+        return;
+    }
+    if (mode_ == COMPRESS_BFLOAT16) {
+        for (std::size_t i = 0; i < cols_; ++i) out[i] = from_bfloat16(half_[j * cols_ + i]);
+        return;
+    }
+
+    const unsigned char* p = &bytes_[0] + offset_[j];
+    long long q1 = 0, q2 = 0;
+    unsigned long long zeros = 0;
+    for (std::size_t i = 0; i < cols_; ++i) {
+        long long d = 0;
+        if (zeros > 0) {
+            zeros--;
+        } else {
+            unsigned long long z = 0;
+            int shift = 0;
+            while (*p & 0x80) {
+                z |= static_cast<unsigned long long>(*p++ & 0x7F) << shift;
+                shift += 7;
+            }
+            z |= static_cast<unsigned long long>(*p++) << shift;
+            if (z & 1) zeros = z >> 1;  //ce résidu nul et les zeros suivants
+            else d = static_cast<long long>(z >> 2) ^ -static_cast<long long>((z >> 1) & 1);
+        }
+
+        long long predicted = (i == 0) ? 0 : (i == 1) ? q1 : 2 * q1 - q2;
+        long long q = predicted + d;
+        q2 = q1;
+        q1 = q;
+        out[i] = static_cast<double>(q) * step_;
+    }
+}
+
+/**
+ * @brief Décompresse toute la surface
+ * @param out Matrice qui reçoit les rows() x cols() valeurs
+ */
+void Compressed_surface::decompress(std::vector< std::vector<double> >& out) const {
+    out.resize(rows_);
+    for (std::size_t j = 0; j < rows_; ++j) decompress_row(j, out[j]);
+}
+
+/**
+ * @brief Getter pour le nombre de lignes
+ * @return Nombre de lignes (pas de temps + 1)
+ */
+std::size_t Compressed_surface::rows() const {
+    return rows_;
+}
+
+/**
+ * @brief Getter pour le nombre de colonnes
+ * @return Nombre de colonnes (points en S)
+ */
+std::size_t Compressed_surface::cols() const {
+    return cols_;
+}
+
+/**
+ * @brief Getter pour le format de compression
+ * @return Format de compression
+ */
+Compression Compressed_surface::mode() const {
+    return mode_;
+}
+
+/**
+ * @brief Borne garantie de l'erreur absolue après décompression
+ * @return Écart maximal entre la surface d'origine et la surface décompressée
+ */
+double Compressed_surface::max_error() const {
+    return max_error_;
+}
+
+/**
+ * @brief Mémoire occupée par les données compressées
+ * @return Nombre d'octets
+ */
+std::size_t Compressed_surface::bytes() const {
+    return half_.size() * sizeof(unsigned short) + bytes_.size() + offset_.size() * sizeof(std::size_t);
+}
+
+/**
+ * @brief Taux de compression par rapport au stockage en double
+ * @return rows() x cols() x sizeof(double) / bytes()
+ */
+double Compressed_surface::compression_ratio() const {
+    std::size_t b = bytes();
+    return (b == 0) ? 0.0 : static_cast<double>(rows_ * cols_ * sizeof(double)) / b;
+}
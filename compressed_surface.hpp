@@ -0,0 +1,154 @@
+/**
+ * @file compressed_surface.hpp
+ * @author Mathias LE BOUEDEC - Lilou MALFOY
+ * @date 2025
+ * @brief Stockage compressé d'une surface (t, S) conservée en mémoire, décompressée ligne par ligne
+ */
+
+#ifndef COMPRESSED_SURFACE_HPP
+#define COMPRESSED_SURFACE_HPP
+
+#include <cstddef>
+#include <vector>
+
+
+/**
+ * @brief Format de compression d'une surface
+ */
+enum Compression {
+    COMPRESS_FLOAT16,   // demi-précision IEEE (11 bits de mantisse, |v| < 65504), 4x
+    COMPRESS_BFLOAT16,  // bfloat16 (8 bits de mantisse, exposant du float), 4x
+    COMPRESS_QUANTIZED  // quantification à erreur bornée + différences secondes le long de S, codage variable
+};
+
+
+/**
+ * @brief Surface de doubles (lignes en temps, colonnes en S) stockée sous forme compressée
+ *
+ * Chaque ligne est compressée indépendamment et peut être décompressée seule.
+ * L'erreur absolue maximale est mesurée sur tous les noeuds à la compression : c'est une borne garantie
+ * de l'écart entre la surface d'origine et la surface décompressée.
+ * En mode COMPRESS_QUANTIZED, les valeurs sont arrondies sur une grille de pas 2 max_error, puis
+ * chaque ligne est codée par différences secondes le long de S (quasi nulles pour un prix régulier en S)
+ * en entiers de longueur variable (1 octet pour |d| < 32), les séries de différences nulles en un seul entier.
+ */
+class Compressed_surface {
+private:
+    Compression mode_;                 // format de compression
+    std::size_t rows_, cols_;          // taille de la surface
+    double step_;                      // pas de quantification (COMPRESS_QUANTIZED)
+    double max_error_;                 // erreur absolue maximale mesurée
+    std::vector<unsigned short> half_; // valeurs float16 ou bfloat16, ligne par ligne
+    std::vector<unsigned char> bytes_; // flux des entiers codés (COMPRESS_QUANTIZED)
+    std::vector<std::size_t> offset_;  // début de chaque ligne dans bytes_ (rows_ + 1 valeurs)
+
+    /**
+     * @brief Compresse une ligne en mode COMPRESS_QUANTIZED
+     * @param row Ligne de la surface
+     */
+    void encode_quantized(const std::vector<double>& row);
+
+    /**
+     * @brief Ajoute un entier au flux, 7 bits par octet (bit de poids fort : octet suivant)
+     * @param z Entier positif
+     */
+    void put_varint(unsigned long long z);
+
+public:
+    /**
+     * @brief Constructeur par défaut (surface vide)
+     */
+    Compressed_surface();
+
+    /**
+     * @brief Compresse une surface
+     * @param v Surface (lignes en temps, colonnes en S, toutes de même longueur)
+     * @param mode Format de compression
+     * @param max_error Erreur absolue maximale demandée (utilisée par COMPRESS_QUANTIZED)
+     * @throw std::invalid_argument si max_error <= 0 en mode quantifié, si les lignes n'ont pas la même
+     *        longueur ou si une valeur n'est pas finie en mode quantifié
+     */
+    Compressed_surface(const std::vector< std::vector<double> >& v, Compression mode, double max_error = 1e-4);
+
+    /**
+     * @brief Décompresse une ligne
+     * @param j Indice de la ligne
+     * @param out Vecteur qui reçoit les cols() valeurs
+     * @throw std::out_of_range si j est hors de la surface
+     */
+    void decompress_row(std::size_t j, std::vector<double>& out) const;
+
+    /**
+     * @brief Décompresse toute la surface
+     * @param out Matrice qui reçoit les rows() x cols() valeurs
+     */
+    void decompress(std::vector< std::vector<double> >& out) const;
+
+    /**
+     * @brief Getter pour le nombre de lignes
+     * @return Nombre de lignes (pas de temps + 1)
+     */
+    std::size_t rows() const;
+
+    /**
+     * @brief Getter pour le nombre de colonnes
+     * @return Nombre de colonnes (points en S)
+     */
+    std::size_t cols() const;
+
+    /**
+     * @brief Getter pour le format de compression
+     * @return Format de compression
+     */
+    Compression mode() const;
+
+    /**
+     * @brief Borne garantie de l'erreur absolue après décompression
+     * @return Écart maximal entre la surface d'origine et la surface décompressée
+     */
+    double max_error() const;
+
+    /**
+     * @brief Mémoire occupée par les données compressées
+     * @return Nombre d'octets
+     */
+    std::size_t bytes() const;
+
+    /**
+     * @brief Taux de compression par rapport au stockage en double
+     * @return rows() x cols() x sizeof(double) / bytes()
+     */
+    double compression_ratio() const;
+};
+
+
+/**
+ * @brief Conversion d'un double en float16 IEEE (arrondi au plus proche, pair en cas d'égalité)
+ * @param x Valeur
+ * @return Motif binaire float16
+ */
+unsigned short to_float16(double x);
+
+/**
+ * @brief Conversion d'un float16 IEEE en double
+ * @param h Motif binaire float16
+ * @return Valeur
+ */
+double from_float16(unsigned short h);
+
+/**
+ * @brief Conversion d'un double en bfloat16 (arrondi au plus proche, pair en cas d'égalité)
+ * @param x Valeur
+ * @return Motif binaire bfloat16
+ */
+unsigned short to_bfloat16(double x);
+
+/**
+ * @brief Conversion d'un bfloat16 en double
+ * @param h Motif binaire bfloat16
+ * @return Valeur
+ */
+double from_bfloat16(unsigned short h);
+
+
+#endif // COMPRESSED_SURFACE_HPP
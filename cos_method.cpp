@@ -0,0 +1,143 @@
+/**
+ * @file cos_method.cpp
+ * @author Mathias LE BOUEDEC - Lilou MALFOY
+ * @date 2025
+ * @brief Implémentation du pricer de Fourier-cosinus (méthode COS de Fang-Oosterlee)
+ */
+
+#include "cos_method.hpp"
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+
+
+/**
+ * @brief Constructeur de la classe Cos_pricer
+ * @param edp Référence vers l'EDP (option, sigma, r, T)
+ * @param n_terms Nombre de termes du développement en cosinus
+ * @param L Largeur de l'intervalle de troncature en écarts-types
+ */
+Cos_pricer::Cos_pricer(EDP& edp, int n_terms, double L)
+    : edp_(edp), n_terms_(std::max(n_terms, 2)), L_(L), ready_(false),
+      sigma_c_(0.0), r_c_(0.0), T_c_(0.0), a_(0.0), b_(0.0), tail_(0.0), last_scale_(0.0) {}
+
+/**
+ * @brief Pré-calcule les termes pour l'intervalle [a, b] et les paramètres courants
+ * @param a Borne inférieure
+ * @param b Borne supérieure
+ */
+void Cos_pricer::prepare(double a, double b) {
+    const double pi = 3.14159265358979323846;
+    double sigma = edp_.getSigma();
+    double T = edp_.getT();
+    double c2 = sigma * sigma * T; //variance de ln(S_T/S0)
+    double w = b - a;
+
+    W_.resize(n_terms_);
+    for (int k = 0; k < n_terms_; ++k) {
+        double u = k * pi / w;
+        //coefficients du payoff put (e^y - 1)^- sur [a, 0] : V_k = 2/(b-a) (psi_k - chi_k)
+        double cos_a = 1.0, cos_0 = std::cos(-u * a), sin_0 = std::sin(-u * a);
+        double chi = (cos_0 - cos_a * std::exp(a) + u * sin_0) / (1.0 + u * u);
+        double psi = (k == 0) ? -a : sin_0 / u;
+        double V = 2.0 / w * (psi - chi);
+        //module de la fonction caractéristique gaussienne ; la phase est ajoutée dans la somme
+        W_[k] = std::exp(-0.5 * c2 * u * u) * V;
+    }
+    W_[0] *= 0.5; //premier terme pondéré par 1/2
+
+    //queue de série (derniers termes) + masse gaussienne hors de l'intervalle + arrondi de la somme
+    double series_tail = 0.0;
+    for (int k = std::max(0, n_terms_ - 4); k < n_terms_; ++k) series_tail += std::abs(W_[k]);
+    tail_ = series_tail + std::erfc(L_ / std::sqrt(2.0)) + n_terms_ * 1e-16;
+
+    sigma_c_ = sigma;
+    r_c_ = edp_.getR();
+    T_c_ = T;
+    a_ = a;
+    b_ = b;
+    ready_ = true;
+}
+
+/**
+ * @brief Prix d'une liste de strikes pour un même sous-jacent
+ * @param S0 Prix initial de l'actif
+ * @param strikes Liste des strikes
+ * @param call true pour des calls, false pour des puts
+ * @return Prix à t=0 pour chaque strike
+ */
+std::vector<double> Cos_pricer::price_strikes(double S0, const std::vector<double>& strikes, bool call) {
+    const double pi = 3.14159265358979323846;
+    std::size_t n = strikes.size();
+    std::vector<double> prices(n, 0.0);
+    if (n == 0) return prices;
+
+    double sigma = edp_.getSigma();
+    double r = edp_.getR();
+    double T = edp_.getT();
+    double c1 = (r - 0.5 * sigma * sigma) * T; //moyenne de ln(S_T/S0)
+    double sd = sigma * std::sqrt(T);
+
+    //intervalle couvrant ln(S_T/K) = x + ln(S_T/S0) pour tous les strikes demandés
+    double x_min = std::log(S0 / *std::max_element(strikes.begin(), strikes.end()));
+    double x_max = std::log(S0 / *std::min_element(strikes.begin(), strikes.end()));
+    double a = std::min(c1 + x_min - L_ * sd, -1e-8);
+    double b = std::max(c1 + x_max + L_ * sd, 1e-8);
+
+    //les termes ne sont recalculés que si (sigma, r, T) changent ou si l'intervalle ne suffit plus
+    if (!ready_ || sigma != sigma_c_ || r != r_c_ || T != T_c_ || a < a_ || b > b_) {
+        prepare(ready_ && sigma == sigma_c_ && r == r_c_ && T == T_c_ ? std::min(a, a_) : a,
+                ready_ && sigma == sigma_c_ && r == r_c_ && T == T_c_ ? std::max(b, b_) : b);
+    }
+
+    //somme de cosinus vectorisée sur les strikes : cos((k+1)w) = 2 cos(w) cos(kw) - cos((k-1)w)
+    std::vector<double> c_prev(n), c_cur(n), two_cos(n), acc(n);
+    for (std::size_t s = 0; s < n; ++s) {
+        double omega = pi * (c1 + std::log(S0 / strikes[s]) - a_) / (b_ - a_);
+        c_prev[s] = std::cos(omega); // cos(-w) : valeur "k = -1"
+        c_cur[s] = 1.0;              // cos(0)
+        two_cos[s] = 2.0 * std::cos(omega);
+        acc[s] = 0.0;
+    }
+    for (int k = 0; k < n_terms_; ++k) {
+        double Wk = W_[k];
+        for (std::size_t s = 0; s < n; ++s) {
+            acc[s] += Wk * c_cur[s];
+            double c_next = two_cos[s] * c_cur[s] - c_prev[s];
+            c_prev[s] = c_cur[s];
+            c_cur[s] = c_next;
+        }
+    }
+
+    double disc = std::exp(-r * T);
+    last_scale_ = 0.0;
+    for (std::size_t s = 0; s < n; ++s) {
+        double K = strikes[s];
+        double put = std::max(K * disc * acc[s], 0.0);
+        prices[s] = call ? std::max(put + S0 - K * disc, 0.0) : put; //parité call-put, plus stable que le call direct
+        last_scale_ = std::max(last_scale_, K * disc);
+    }
+    return prices;
+}
+
+/**
+ * @brief Prix à t=0 de l'option de l'EDP (Call ou Put)
+ * @param S0 Prix initial de l'actif
+ * @return Prix de l'option
+ */
+double Cos_pricer::price(double S0) {
+    const Option* option = edp_.getOption();
+    bool call = dynamic_cast<const Call*>(option) != nullptr;
+    if (!call && dynamic_cast<const Put*>(option) == nullptr) {
+        throw std::invalid_argument("Cos_pricer : seules les options Call et Put sont prises en charge");
+    }
+    return price_strikes(S0, std::vector<double>(1, option->getK()), call)[0];
+}
+
+/**
+ * @brief Estimation de l'erreur de troncature du dernier calcul
+ * @return Borne estimée de l'erreur absolue (queue de série + masse hors de [a, b])
+ */
+double Cos_pricer::truncation_error() const {
+    return tail_ * last_scale_;
+}
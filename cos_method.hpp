@@ -0,0 +1,77 @@
+/**
+ * @file cos_method.hpp
+ * @author Mathias LE BOUEDEC - Lilou MALFOY
+ * @date 2025
+ * @brief Définition du pricer de Fourier-cosinus (méthode COS de Fang-Oosterlee) pour options européennes
+ */
+
+#ifndef COS_METHOD_HPP
+#define COS_METHOD_HPP
+
+#include "edp.hpp"
+#include <vector>
+
+
+/**
+ * @brief Pricer COS : développement en cosinus de la densité de ln(S_T/K)
+ *
+ * Les termes de la fonction caractéristique et les coefficients du payoff sont
+ * calculés une seule fois pour (sigma, r, T) ; chaque strike ne coûte ensuite
+ * qu'une somme de cosinus.
+ */
+class Cos_pricer {
+private:
+    EDP& edp_;        // Référence vers l'EDP (option, sigma, r, T)
+    int n_terms_;     // Nombre de termes du développement
+    double L_;        // Largeur de l'intervalle de troncature (en écarts-types)
+
+    // cache des termes pré-calculés
+    bool ready_;      // true si le cache est valide
+    double sigma_c_, r_c_, T_c_; // paramètres ayant servi au cache
+    double a_, b_;    // intervalle de troncature en ln(S_T/K)
+    std::vector<double> W_; // poids W_k = |phi(u_k)| * V_k (put) pour chaque terme
+    double tail_;     // estimation relative de l'erreur de troncature
+    double last_scale_; // K e^{-rT} maximal du dernier calcul, pour convertir tail_ en erreur absolue
+
+    /**
+     * @brief Pré-calcule les termes pour l'intervalle [a, b] et les paramètres courants
+     * @param a Borne inférieure
+     * @param b Borne supérieure
+     */
+    void prepare(double a, double b);
+
+public:
+    /**
+     * @brief Constructeur de la classe Cos_pricer
+     * @param edp Référence vers l'EDP (option, sigma, r, T)
+     * @param n_terms Nombre de termes du développement en cosinus
+     * @param L Largeur de l'intervalle de troncature en écarts-types
+     */
+    Cos_pricer(EDP& edp, int n_terms = 128, double L = 10.0);
+
+    /**
+     * @brief Prix d'une liste de strikes pour un même sous-jacent
+     * @param S0 Prix initial de l'actif
+     * @param strikes Liste des strikes
+     * @param call true pour des calls, false pour des puts
+     * @return Prix à t=0 pour chaque strike
+     */
+    std::vector<double> price_strikes(double S0, const std::vector<double>& strikes, bool call);
+
+    /**
+     * @brief Prix à t=0 de l'option de l'EDP (Call ou Put)
+     * @param S0 Prix initial de l'actif
+     * @return Prix de l'option
+     * @throw std::invalid_argument si l'option n'est ni un Call ni un Put
+     */
+    double price(double S0);
+
+    /**
+     * @brief Estimation de l'erreur de troncature du dernier calcul
+     * @return Borne estimée de l'erreur absolue (queue de série + masse hors de [a, b])
+     */
+    double truncation_error() const;
+};
+
+
+#endif // COS_METHOD_HPP
@@ -0,0 +1,135 @@
+/**
+ * @file domain.cpp
+ * @author Mathias LE BOUEDEC - Lilou MALFOY
+ * @date 2025
+ * @brief Implémentation du choix automatique du domaine de calcul
+ */
+
+#include "domain.hpp"
+#include "analytic.hpp"
+#include <algorithm>
+#include <cmath>
+
+/**
+ * @brief Probabilité qu'un mouvement brownien géométrique touche un niveau avant T (principe de réflexion)
+ * @param S Prix de départ
+ * @param level Niveau à atteindre (au-dessus ou en dessous de S)
+ * @param drift Dérive de ln S (r - sigma^2/2)
+ * @param sigma Volatilité
+ * @param T Horizon
+ * @return P(le niveau est touché sur [0, T])
+ */
+double hit_probability(double S, double level, double drift, double sigma, double T) {
+    if (level <= 0.0) return 0.0;
+    double b = std::log(level / S);
+    if (b == 0.0) return 1.0;
+    if (T <= 0.0 || sigma <= 0.0) return 0.0;
+    //niveau en dessous : on se ramène à un niveau au-dessus pour -ln S
+    double mu = (b > 0.0) ? drift : -drift;
+    b = std::fabs(b);
+
+    double sq = sigma * std::sqrt(T);
+    double p = normal_cdf((-b + mu * T) / sq);
+    double tail = normal_cdf((-b - mu * T) / sq);
+    if (tail > 0.0) {
+        //exp(2 mu b / sigma^2) peut déborder alors que le produit reste petit
+        p += std::exp(2.0 * mu * b / (sigma * sigma) + std::log(tail));
+    }
+    return std::min(p, 1.0);
+}
+
+/**
+ * @brief Écart maximal entre la condition de Dirichlet de l'option et son vrai prix au bord S = s, sur [0, T]
+ * @param edp EDP contenant l'option
+ * @param s Prix au bord
+ * @param high true pour le bord haut, false pour le bord bas
+ * @return Écart maximal (formule fermée pour Call/Put, ordre de grandeur de l'option sinon)
+ */
+double boundary_mismatch(const EDP& edp, double s, bool high) {
+    const Option* option = edp.getOption();
+    const Call* call = dynamic_cast<const Call*>(option);
+    const Put* put = dynamic_cast<const Put*>(option);
+    double T = edp.getT();
+    double K = option->getK();
+
+    //quelques instants suffisent : les écarts sont monotones en tau pour les options vanilles
+    const int n_samples = 8;
+    double mismatch = 0.0;
+    for (int k = 0; k <= n_samples; ++k) {
+        double tau = T * k / n_samples;
+        double t = T - tau;
+        double bc = high ? option->boundary_condition_high(s, t, edp.discount_curve())
+                         : option->boundary_condition_low(s, t, edp.discount_curve());
+        double exact;
+        if (call) {
+            exact = black_scholes_call(s, K, edp.getR(), edp.getSigma(), tau);
+        } else if (put) {
+            exact = black_scholes_put(s, K, edp.getR(), edp.getSigma(), tau);
+        } else {
+            //pas de formule fermée : on borne par l'ordre de grandeur de l'option au bord
+            exact = 0.0;
+            bc = std::max(std::fabs(bc), std::fabs(option->payoff(s)));
+        }
+        mismatch = std::max(mismatch, std::fabs(bc - exact));
+    }
+    return mismatch;
+}
+
+/**
+ * @brief Erreur sur les prix aux spots induite par des bords en s_low et s_high
+ * @param edp EDP à résoudre
+ * @param s_low Borne basse (0 : pas de bord bas, un brownien géométrique ne touche jamais 0)
+ * @param s_high Borne haute
+ * @param spots Prix de l'actif où l'on veut le prix
+ * @return Erreur estimée
+ */
+double boundary_error_estimate(const EDP& edp, double s_low, double s_high, const std::vector<double>& spots) {
+    double sigma = edp.getSigma();
+    double drift = edp.getR() - 0.5 * sigma * sigma;
+    double T = edp.getT();
+
+    //une barrière sur le bord haut est une condition exacte
+    double mismatch_high = (edp.getOption()->upper_barrier() <= s_high) ? 0.0 : boundary_mismatch(edp, s_high, true);
+    double mismatch_low = (s_low > 0.0) ? boundary_mismatch(edp, s_low, false) : 0.0;
+
+    double error = 0.0;
+    for (std::size_t k = 0; k < spots.size(); ++k) {
+        double S = spots[k];
+        if (S <= s_low || S >= s_high) return std::max(mismatch_high, mismatch_low); //spot hors du domaine
+        double e = hit_probability(S, s_high, drift, sigma, T) * mismatch_high;
+        if (s_low > 0.0) e += hit_probability(S, s_low, drift, sigma, T) * mismatch_low;
+        error = std::max(error, e);
+    }
+    return error;
+}
+
+/**
+ * @brief Domaine à n_std écarts-types en log-prix autour des spots et du strike
+ * @param edp EDP à résoudre (K, sigma, r, T, barrière éventuelle)
+ * @param spots Prix de l'actif où l'on veut le prix (le strike seul si vide)
+ * @param n_std Nombre d'écarts-types sigma sqrt(T) de chaque côté
+ * @return Domaine choisi avec son erreur de bord estimée
+ */
+Domain choose_domain(const EDP& edp, const std::vector<double>& spots, double n_std) {
+    double K = edp.getOption()->getK();
+    double sigma = edp.getSigma();
+    double T = edp.getT();
+    double drift = edp.getR() - 0.5 * sigma * sigma;
+
+    //le coude du payoff et tous les spots doivent être à l'intérieur du domaine
+    std::vector<double> points = spots.empty() ? std::vector<double>(1, K) : spots;
+    double s_min = K, s_max = K;
+    for (std::size_t k = 0; k < points.size(); ++k) {
+        s_min = std::min(s_min, points[k]);
+        s_max = std::max(s_max, points[k]);
+    }
+
+    //n_std écarts-types en log-prix, plus la dérive dans le sens où elle éloigne du centre
+    double width = n_std * sigma * std::sqrt(T);
+    Domain domain;
+    domain.s_high = s_max * std::exp(std::max(drift, 0.0) * T + width);
+    domain.s_low = s_min * std::exp(std::min(drift, 0.0) * T - width);
+    domain.s_high = std::min(domain.s_high, edp.getOption()->upper_barrier());
+    domain.boundary_error = boundary_error_estimate(edp, domain.s_low, domain.s_high, points);
+    return domain;
+}
@@ -0,0 +1,67 @@
+/**
+ * @file domain.hpp
+ * @author Mathias LE BOUEDEC - Lilou MALFOY
+ * @date 2025
+ * @brief Choix automatique du domaine de calcul [s_low, s_high] et estimation de l'erreur due aux bords
+ */
+
+#ifndef DOMAIN_HPP
+#define DOMAIN_HPP
+
+#include "edp.hpp"
+#include <vector>
+
+
+/**
+ * @brief Domaine de calcul en prix de l'actif
+ */
+struct Domain {
+    double s_low;          // borne basse (utilisée par le solveur en log-prix, 0 pour Crank-Nicolson)
+    double s_high;         // borne haute (remplace L)
+    double boundary_error; // erreur estimée sur les prix aux spots demandés due aux conditions aux bords
+};
+
+
+/**
+ * @brief Probabilité qu'un mouvement brownien géométrique touche un niveau avant T (principe de réflexion)
+ * @param S Prix de départ
+ * @param level Niveau à atteindre (au-dessus ou en dessous de S)
+ * @param drift Dérive de ln S (r - sigma^2/2)
+ * @param sigma Volatilité
+ * @param T Horizon
+ * @return P(le niveau est touché sur [0, T])
+ */
+double hit_probability(double S, double level, double drift, double sigma, double T);
+
+/**
+ * @brief Écart maximal entre la condition de Dirichlet de l'option et son vrai prix au bord S = s, sur [0, T]
+ * @param edp EDP contenant l'option
+ * @param s Prix au bord
+ * @param high true pour le bord haut, false pour le bord bas
+ * @return Écart maximal (formule fermée pour Call/Put, ordre de grandeur de l'option sinon)
+ */
+double boundary_mismatch(const EDP& edp, double s, bool high);
+
+/**
+ * @brief Erreur sur les prix aux spots induite par des bords en s_low et s_high
+ *
+ * Borne du type P(toucher le bord) x (écart de la condition au bord), maximisée sur les spots.
+ * @param edp EDP à résoudre
+ * @param s_low Borne basse (0 : pas de bord bas, un brownien géométrique ne touche jamais 0)
+ * @param s_high Borne haute
+ * @param spots Prix de l'actif où l'on veut le prix
+ * @return Erreur estimée
+ */
+double boundary_error_estimate(const EDP& edp, double s_low, double s_high, const std::vector<double>& spots);
+
+/**
+ * @brief Domaine à n_std écarts-types en log-prix autour des spots et du strike
+ * @param edp EDP à résoudre (K, sigma, r, T, barrière éventuelle)
+ * @param spots Prix de l'actif où l'on veut le prix (le strike seul si vide)
+ * @param n_std Nombre d'écarts-types sigma sqrt(T) de chaque côté
+ * @return Domaine choisi avec son erreur de bord estimée
+ */
+Domain choose_domain(const EDP& edp, const std::vector<double>& spots, double n_std = 5.0);
+
+
+#endif // DOMAIN_HPP
@@ -6,6 +6,9 @@
  */
 
 #include "edp.hpp"
+#include <algorithm>
+#include <cmath>
+#include <iterator>
 
 /**
  * @brief Constructeur de la classe EDP
@@ -16,7 +19,7 @@
  * @param L Valeur maximale de l'actif sous-jacent
  */
 EDP::EDP(Option* option, double sigma, double r, double T, double L)
-    : option_(option), sigma_(sigma), r_(r), T_(T), L_(L) {}
+    : option_(option), sigma_(sigma), r_(r), T_(T), L_(L), rate_(r), vol_(sigma), term_structure_(false), rate_curve_set_(false) {}
 
 /**
  * @brief Getter pour l'option
@@ -34,6 +37,15 @@ double EDP::getSigma() const {
     return sigma_;
 }
 
+/**
+ * @brief Volatilité au temps t
+ * @param t Temps calendaire
+ * @return sigma(t)
+ */
+double EDP::getSigma(double t) const {
+    return term_structure_ ? vol_.value(t) : sigma_;
+}
+
 /**
  * @brief Getter pour le taux d'intérêt
  * @return Taux d'intérêt sans risque
@@ -42,6 +54,15 @@ double EDP::getR() const {
     return r_;
 }
 
+/**
+ * @brief Taux d'intérêt au temps t
+ * @param t Temps calendaire
+ * @return r(t)
+ */
+double EDP::getR(double t) const {
+    return term_structure_ ? rate_.value(t) : r_;
+}
+
 /**
  * @brief Getter pour le temps terminal
  * @return Temps terminal
@@ -57,3 +78,72 @@ double EDP::getT() const {
 double EDP::getL() const {
     return L_;
 }
+
+/**
+ * @brief Remplace sigma et r par des courbes constantes par morceaux en temps calendaire
+ * @param rate Taux r(t)
+ * @param vol Volatilité sigma(t)
+ */
+void EDP::set_term_structure(const Piecewise_curve& rate, const Piecewise_curve& vol) {
+    rate_ = rate;
+    vol_ = vol;
+    term_structure_ = !rate.is_flat() || !vol.is_flat();
+
+    //constantes équivalentes : même actualisation et même variance totale sur [0, T]
+    r_ = rate.integral(0.0, T_) / T_;
+    sigma_ = std::sqrt(vol.integral_squared(0.0, T_) / T_);
+    rate_curve_set_ = true;
+}
+
+/**
+ * @brief Courbe d'actualisation à passer aux conditions aux bords de l'option
+ * @return Courbe de taux après set_term_structure, 0 sinon (taux constant de l'option)
+ */
+const Piecewise_curve* EDP::discount_curve() const {
+    return rate_curve_set_ ? &rate_ : nullptr;
+}
+
+/**
+ * @brief Indique si r ou sigma dépend du temps
+ * @return true après set_term_structure avec une courbe non constante
+ */
+bool EDP::has_term_structure() const {
+    return term_structure_;
+}
+
+/**
+ * @brief Dates de changement de r ou de sigma strictement entre 0 et T
+ * @return Dates croissantes, sans doublon
+ */
+std::vector<double> EDP::breakpoints() const {
+    std::vector<double> dates;
+    if (!term_structure_) return dates;
+    const std::vector<double>& rt = rate_.times();
+    const std::vector<double>& vt = vol_.times();
+    std::merge(rt.begin(), rt.end(), vt.begin(), vt.end(), std::back_inserter(dates));
+    dates.erase(std::unique(dates.begin(), dates.end()), dates.end());
+
+    std::vector<double> inside;
+    for (std::size_t k = 0; k < dates.size(); ++k) {
+        if (dates[k] > 0.0 && dates[k] < T_) inside.push_back(dates[k]);
+    }
+    return inside;
+}
+
+/**
+ * @brief Taux cumulé sur les tau dernières années avant la maturité
+ * @param tau Temps avant maturité
+ * @return Intégrale de r(t) sur [T - tau, T]
+ */
+double EDP::rate_integral(double tau) const {
+    return term_structure_ ? rate_.integral(T_ - tau, T_) : r_ * tau;
+}
+
+/**
+ * @brief Variance cumulée sur les tau dernières années avant la maturité
+ * @param tau Temps avant maturité
+ * @return Intégrale de sigma(t)^2 sur [T - tau, T]
+ */
+double EDP::variance_integral(double tau) const {
+    return term_structure_ ? vol_.integral_squared(T_ - tau, T_) : sigma_ * sigma_ * tau;
+}
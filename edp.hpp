@@ -10,6 +10,8 @@
 #define EDP_HPP
 
 #include "payoff.hpp" //pour la déclaration de la classe payoff
+#include "term_structure.hpp"
+#include <vector>
 
 
 /**
@@ -23,6 +25,10 @@ class EDP {
         double r_;     // Taux d'intérêt sans risque
         double T_;     // Temps terminal 
         double L_;     // Valeur maximale de l'actif sous-jacent
+        Piecewise_curve rate_;   // Taux r(t) (constant : r_)
+        Piecewise_curve vol_;    // Volatilité sigma(t) (constante : sigma_)
+        bool term_structure_;    // true si r ou sigma dépend du temps
+        bool rate_curve_set_;    // true après set_term_structure : rate_ actualise les conditions aux bords
 
     public:
         /**
@@ -46,6 +52,13 @@ class EDP {
         * @return Volatilité de l'actif sous-jacent
         */
         double getSigma() const;
+
+        /**
+        * @brief Volatilité au temps t
+        * @param t Temps calendaire
+        * @return sigma(t)
+        */
+        double getSigma(double t) const;
         
         /**
         * @brief Getter pour le taux d'intérêt
@@ -53,6 +66,13 @@ class EDP {
         */
         double getR() const;
 
+        /**
+        * @brief Taux d'intérêt au temps t
+        * @param t Temps calendaire
+        * @return r(t)
+        */
+        double getR(double t) const;
+
         /**
         * @brief Getter pour le temps terminal
         * @return Temps terminal
@@ -64,6 +84,52 @@ class EDP {
         * @return Valeur maximale de l'actif sous-jacent
         */
         double getL() const;
+
+        /**
+        * @brief Remplace sigma et r par des courbes constantes par morceaux en temps calendaire
+        *
+        * getSigma() et getR() renvoient ensuite les constantes équivalentes sur [0, T] (volatilité
+        * quadratique moyenne et taux moyen), qui donnent le même prix européen ; l'actualisation
+        * des conditions aux bords suit la courbe de taux (voir discount_curve). L'option n'est pas
+        * modifiée et peut être partagée avec d'autres EDP.
+        * @param rate Taux r(t)
+        * @param vol Volatilité sigma(t)
+        */
+        void set_term_structure(const Piecewise_curve& rate, const Piecewise_curve& vol);
+
+        /**
+        * @brief Courbe d'actualisation à passer aux conditions aux bords de l'option
+        *
+        * Les dérivées *_dr des conditions aux bords restent celles d'un décalage parallèle de la courbe.
+        * @return Courbe de taux après set_term_structure, 0 sinon (taux constant de l'option)
+        */
+        const Piecewise_curve* discount_curve() const;
+
+        /**
+        * @brief Indique si r ou sigma dépend du temps
+        * @return true après set_term_structure avec une courbe non constante
+        */
+        bool has_term_structure() const;
+
+        /**
+        * @brief Dates de changement de r ou de sigma strictement entre 0 et T
+        * @return Dates croissantes, sans doublon
+        */
+        std::vector<double> breakpoints() const;
+
+        /**
+        * @brief Taux cumulé sur les tau dernières années avant la maturité
+        * @param tau Temps avant maturité
+        * @return Intégrale de r(t) sur [T - tau, T]
+        */
+        double rate_integral(double tau) const;
+
+        /**
+        * @brief Variance cumulée sur les tau dernières années avant la maturité
+        * @param tau Temps avant maturité
+        * @return Intégrale de sigma(t)^2 sur [T - tau, T]
+        */
+        double variance_integral(double tau) const;
 };
 
 
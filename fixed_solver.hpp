@@ -0,0 +1,285 @@
+/**
+ * @file fixed_solver.hpp
+ * @author Mathias LE BOUEDEC - Lilou MALFOY
+ * @date 2025
+ * @brief Solveur Crank-Nicolson à taille de grille fixée à la compilation, pour les petites grilles des boucles de calibration
+ *
+ * N et M sont des paramètres du modèle : grilles, lignes de solution, opérateur et factorisation sont des
+ * std::array membres (l'objet vit sur la pile), les boucles ont des bornes constantes et l'appel à solve()
+ * n'est pas virtuel. Aucune allocation, même au premier appel. Le schéma reproduit celui de Cranck_nicolson
+ * (grille uniforme sur [0, L], theta-schéma, démarrage de Rannacher) pour r et sigma constants : les prix
+ * sont identiques à l'arrondi près. Une EDP avec structure par terme est refusée. Seule la ligne t=0 est conservée.
+ */
+
+#ifndef FIXED_SOLVER_HPP
+#define FIXED_SOLVER_HPP
+
+#include <array>
+#include <cmath>
+#include <stdexcept>
+#include "edp.hpp"
+#include "time_stepping.hpp"
+
+
+/**
+ * @brief Crank-Nicolson (ou Euler implicite, ou Rannacher) sur une grille de N pas en S et M pas de temps fixés
+ * @tparam N Nombre de pas en S
+ * @tparam M Nombre de pas de temps
+ */
+template <int N, int M>
+class Fixed_cranck_nicolson {
+    static_assert(N >= 2, "Fixed_cranck_nicolson : au moins un noeud intérieur");
+    static_assert(M >= 1, "Fixed_cranck_nicolson : au moins un pas de temps");
+
+public:
+    typedef std::array<double, N + 1> Row;
+
+private:
+    const EDP& edp_;
+    double L_;   // borne haute du domaine
+    double dS_;  // pas en espace
+    double dt_;  // pas de temps
+    Time_scheme scheme_;
+    int rannacher_steps_;
+
+    Row lower_, diag_, upper_; // opérateur de Black-Scholes sur les noeuds intérieurs
+    Row gl_, cp_, inv_;        // factorisation de Thomas de (I - c A), gl = c * lower * inv
+    Row rows_[2];              // lignes de solution alternées (la ligne courante est rows_[current_])
+    Row stage_;                // demi-pas de Rannacher
+    int current_;
+
+    /**
+     * @brief Conditions de Dirichlet au temps avant maturité tau
+     * @param tau Temps avant maturité
+     * @param low Valeur en S = 0
+     * @param high Valeur en S = L
+     */
+    void boundary_values(double tau, double& low, double& high) const;
+
+    /**
+     * @brief Factorise (I - c A) sur les noeuds intérieurs
+     * @param c Coefficient du système
+     */
+    void factorize(double c);
+
+    /**
+     * @brief Pas du theta-schéma : u_new = (I - c A)^-1 (u_old + w A u_old), bords de u_new déjà fixés
+     * @param u_old Solution au début du pas
+     * @param u_new Solution à la fin du pas
+     * @param w (1 - theta) dt (0 pour un pas implicite)
+     * @param c theta dt, celui de la factorisation
+     */
+    void theta_step(const Row& u_old, Row& u_new, double w, double c) const;
+
+public:
+    /**
+     * @brief Constructeur (grille uniforme sur [0, L], arrêtée sur la barrière haute si l'option en a une)
+     * @param edp EDP à résoudre (r et sigma constants)
+     * @throws std::invalid_argument si l'EDP porte une structure par terme
+     */
+    explicit Fixed_cranck_nicolson(const EDP& edp);
+
+    /**
+     * @brief Choix du schéma en temps
+     * @param scheme SCHEME_CRANK_NICOLSON, SCHEME_IMPLICIT ou SCHEME_RANNACHER (les autres schémas sont refusés)
+     * @param rannacher_steps Nombre de pas remplacés par deux demi-pas implicites (SCHEME_RANNACHER)
+     */
+    void set_time_scheme(Time_scheme scheme, int rannacher_steps = 2);
+
+    /**
+     * @brief Résout l'équation de Black-Scholes de tau = 0 à tau = T
+     */
+    void solve();
+
+    /**
+     * @brief Getter pour la solution à t=0
+     * @return Valeurs aux noeuds S_i = i dS
+     */
+    const Row& get_row() const;
+
+    /**
+     * @brief Prix à t=0 par interpolation linéaire en S entre les deux noeuds voisins
+     * @param s_target Prix de l'actif
+     * @return Valeur de l'option
+     */
+    double get_value_at_S(double s_target) const;
+
+    /**
+     * @brief Getter pour le pas en espace
+     * @return dS
+     */
+    double getdS() const;
+};
+
+
+/**
+ * @brief Constructeur (grille uniforme sur [0, L], arrêtée sur la barrière haute si l'option en a une)
+ * @param edp EDP à résoudre (r et sigma constants)
+ * @throws std::invalid_argument si l'EDP porte une structure par terme
+ */
+template <int N, int M>
+Fixed_cranck_nicolson<N, M>::Fixed_cranck_nicolson(const EDP& edp)
+    : edp_(edp), scheme_(SCHEME_RANNACHER), rannacher_steps_(2), current_(0) {
+    //l'opérateur n'utilise que getR() et getSigma() : une courbe serait remplacée en silence par sa moyenne
+    if (edp_.has_term_structure()) {
+        throw std::invalid_argument("Fixed_cranck_nicolson : structure par terme non prise en charge");
+    }
+    L_ = edp_.getL();
+    double barrier = edp_.getOption()->upper_barrier();
+    if (barrier <= L_) L_ = barrier;
+    dS_ = L_ / static_cast<double>(N);
+    dt_ = edp_.getT() / static_cast<double>(M);
+}
+
+/**
+ * @brief Choix du schéma en temps
+ * @param scheme SCHEME_CRANK_NICOLSON, SCHEME_IMPLICIT ou SCHEME_RANNACHER (les autres schémas sont refusés)
+ * @param rannacher_steps Nombre de pas remplacés par deux demi-pas implicites (SCHEME_RANNACHER)
+ */
+template <int N, int M>
+void Fixed_cranck_nicolson<N, M>::set_time_scheme(Time_scheme scheme, int rannacher_steps) {
+    if (scheme != SCHEME_CRANK_NICOLSON && scheme != SCHEME_IMPLICIT && scheme != SCHEME_RANNACHER) {
+        throw std::invalid_argument("Fixed_cranck_nicolson : schéma non pris en charge");
+    }
+    if (rannacher_steps < 0) throw std::invalid_argument("Fixed_cranck_nicolson : rannacher_steps doit être positif");
+    scheme_ = scheme;
+    rannacher_steps_ = rannacher_steps;
+}
+
+/**
+ * @brief Conditions de Dirichlet au temps avant maturité tau
+ * @param tau Temps avant maturité
+ * @param low Valeur en S = 0
+ * @param high Valeur en S = L
+ */
+template <int N, int M>
+void Fixed_cranck_nicolson<N, M>::boundary_values(double tau, double& low, double& high) const {
+    double t = edp_.getT() - tau;
+    low = edp_.getOption()->boundary_condition_low(0.0, t, edp_.discount_curve());
+    high = edp_.getOption()->boundary_condition_high(L_, t, edp_.discount_curve());
+}
+
+/**
+ * @brief Factorise (I - c A) sur les noeuds intérieurs
+ * @param c Coefficient du système
+ */
+template <int N, int M>
+void Fixed_cranck_nicolson<N, M>::factorize(double c) {
+    //mêmes pivots que Time_stepper::factorization
+    double prev_cp = 0.0;
+    for (int i = 1; i < N; ++i) {
+        double a = -c * lower_[i];
+        double denom = 1.0 - c * diag_[i] - a * prev_cp;
+        if (std::abs(denom) < 1e-20) denom = 1e-20;
+        inv_[i] = 1.0 / denom;
+        cp_[i] = -c * upper_[i] * inv_[i];
+        gl_[i] = c * lower_[i] * inv_[i];
+        prev_cp = cp_[i];
+    }
+}
+
+/**
+ * @brief Pas du theta-schéma : u_new = (I - c A)^-1 (u_old + w A u_old), bords de u_new déjà fixés
+ * @param u_old Solution au début du pas
+ * @param u_new Solution à la fin du pas
+ * @param w (1 - theta) dt (0 pour un pas implicite)
+ * @param c theta dt, celui de la factorisation
+ */
+template <int N, int M>
+void Fixed_cranck_nicolson<N, M>::theta_step(const Row& u_old, Row& u_new, double w, double c) const {
+    //membre de droite et descente en une passe ; gl_ = c l_i inv_i raccourcit la dépendance d'un noeud au suivant
+    Row d;
+    double prev = 0.0;
+    for (int i = 1; i < N; ++i) {
+        double f = (w != 0.0) ? u_old[i] + w * (lower_[i] * u_old[i - 1] + diag_[i] * u_old[i] + upper_[i] * u_old[i + 1])
+                              : u_old[i];
+        if (i == 1) f += c * lower_[1] * u_new[0];         //conditions aux limites dans le membre de droite
+        if (i == N - 1) f += c * upper_[N - 1] * u_new[N];
+        prev = f * inv_[i] + gl_[i] * prev;
+        d[i] = prev;
+    }
+    u_new[N - 1] = d[N - 1];
+    for (int i = N - 2; i >= 1; --i) u_new[i] = d[i] - cp_[i] * u_new[i + 1];
+}
+
+/**
+ * @brief Résout l'équation de Black-Scholes de tau = 0 à tau = T
+ */
+template <int N, int M>
+void Fixed_cranck_nicolson<N, M>::solve() {
+    const double r = edp_.getR(), sigma = edp_.getSigma();
+    const Option* option = edp_.getOption();
+
+    //opérateur de Black-Scholes en différences centrées, comme Cranck_nicolson::fill_operator
+    for (int i = 1; i < N; ++i) {
+        double s_i = i * dS_;
+        double sigma2_s2 = sigma * sigma * s_i * s_i;
+        lower_[i] = 0.5 * (sigma2_s2 / (dS_ * dS_) - r * s_i / dS_);
+        diag_[i]  = - (sigma2_s2 / (dS_ * dS_) + r);
+        upper_[i] = 0.5 * (sigma2_s2 / (dS_ * dS_) + r * s_i / dS_);
+    }
+
+    //Crank-Nicolson et les demi-pas de Rannacher partagent c = dt / 2 : une seule factorisation
+    const bool implicit = scheme_ == SCHEME_IMPLICIT;
+    const double c = implicit ? dt_ : 0.5 * dt_;
+    const double w = implicit ? 0.0 : 0.5 * dt_;
+    factorize(c);
+
+    current_ = 0;
+    for (int i = 0; i <= N; ++i) rows_[0][i] = option->payoff(i * dS_);
+
+    for (int k = 1; k <= M; ++k) {
+        const Row& u_old = rows_[current_];
+        Row& u_new = rows_[1 - current_];
+        double tau_old = (k - 1) * dt_;
+        boundary_values(tau_old + dt_, u_new[0], u_new[N]);
+
+        if (scheme_ == SCHEME_RANNACHER && k <= rannacher_steps_) {
+            //deux demi-pas implicites amortissent le coude du payoff
+            boundary_values(tau_old + 0.5 * dt_, stage_[0], stage_[N]);
+            theta_step(u_old, stage_, 0.0, c);
+            theta_step(stage_, u_new, 0.0, c);
+        } else {
+            theta_step(u_old, u_new, w, c);
+        }
+        current_ = 1 - current_;
+    }
+}
+
+/**
+ * @brief Getter pour la solution à t=0
+ * @return Valeurs aux noeuds S_i = i dS
+ */
+template <int N, int M>
+const typename Fixed_cranck_nicolson<N, M>::Row& Fixed_cranck_nicolson<N, M>::get_row() const {
+    return rows_[current_];
+}
+
+/**
+ * @brief Prix à t=0 par interpolation linéaire en S entre les deux noeuds voisins
+ * @param s_target Prix de l'actif
+ * @return Valeur de l'option
+ */
+template <int N, int M>
+double Fixed_cranck_nicolson<N, M>::get_value_at_S(double s_target) const {
+    const Row& v = rows_[current_];
+    if (s_target <= 0.0) return v[0];
+    if (s_target >= L_) return v[N];
+    int i = static_cast<int>(s_target / dS_);
+    if (i > N - 1) i = N - 1;
+    double s_inf = i * dS_;
+    double w = (s_target - s_inf) / dS_;
+    return (1.0 - w) * v[i] + w * v[i + 1];
+}
+
+/**
+ * @brief Getter pour le pas en espace
+ * @return dS
+ */
+template <int N, int M>
+double Fixed_cranck_nicolson<N, M>::getdS() const {
+    return dS_;
+}
+
+
+#endif // FIXED_SOLVER_HPP
@@ -12,13 +12,81 @@
 #include "payoff.hpp"
 #include "edp.hpp"
 #include "solver.hpp"
+#include "analytic.hpp"
 #include "sdl.hpp"
 
+/**
+ * @brief Surface d'erreur |V - Black-Scholes| aux noeuds (lignes en temps, colonnes en S)
+ * @param v Surface de prix (ligne j : t = j T/M)
+ * @param s Grille en S
+ * @param edp EDP résolue (K, r, sigma, T)
+ * @param is_call true pour un call, false pour un put
+ * @return Surface des erreurs absolues
+ */
+static std::vector< std::vector<double> > error_surface(const std::vector< std::vector<double> >& v, const std::vector<double>& s,
+                                                        const EDP& edp, bool is_call) {
+    int M = static_cast<int>(v.size()) - 1;
+    double K = edp.getOption()->getK();
+    std::vector< std::vector<double> > err(v.size(), std::vector<double>(s.size()));
+    for (int j = 0; j <= M; ++j) {
+        double tau = edp.getT() * (1.0 - static_cast<double>(j) / M);
+        for (std::size_t i = 0; i < s.size(); ++i) {
+            double exact = is_call ? black_scholes_call(s[i], K, edp.getR(), edp.getSigma(), tau)
+                                   : black_scholes_put(s[i], K, edp.getR(), edp.getSigma(), tau);
+            err[j][i] = std::abs(v[j][i] - exact);
+        }
+    }
+    return err;
+}
+
+/**
+ * @brief Surface des deltas par différences centrées (décentrées aux bords)
+ * @param v Surface de prix
+ * @param dS Pas de la grille en S
+ * @return Surface des deltas
+ */
+static std::vector< std::vector<double> > delta_surface(const std::vector< std::vector<double> >& v, double dS) {
+    std::vector< std::vector<double> > delta(v.size(), std::vector<double>(v[0].size()));
+    std::size_t n = v[0].size() - 1;
+    for (std::size_t j = 0; j < v.size(); ++j) {
+        for (std::size_t i = 1; i < n; ++i) delta[j][i] = (v[j][i + 1] - v[j][i - 1]) / (2.0 * dS);
+        delta[j][0] = (v[j][1] - v[j][0]) / dS;
+        delta[j][n] = (v[j][n] - v[j][n - 1]) / dS;
+    }
+    return delta;
+}
+
+/**
+ * @brief Contexte de l'affichage pendant une résolution
+ */
+struct Live_view {
+    Heatmap* heatmap;        // carte à mettre à jour
+    const Solver* solver;    // solveur en cours
+    SDL_Renderer* renderer;  // renderer de la fenêtre
+};
+
+/**
+ * @brief Suivi de la marche en temps : envoie les lignes prêtes dans la texture et affiche
+ * @param user Pointeur vers un Live_view
+ * @param row_begin Première ligne prête
+ * @param row_end Ligne suivant la dernière ligne prête
+ */
+static void live_progress(void* user, int row_begin, int row_end) {
+    Live_view* view = static_cast<Live_view*>(user);
+    view->heatmap->update_rows(view->solver->get_surface(), row_begin, row_end);
+    view->heatmap->draw();
+    SDL_RenderPresent(view->renderer);
+    SDL_PumpEvents();
+}
+
 int main() {
     std::cout << "Affichage des courbes :" << std::endl;
     std::cout << "  Appuyer sur 'C' pour afficher le CALL" << std::endl;
     std::cout << "  Appuyer sur 'P' pour afficher le PUT" << std::endl;
     std::cout << "  Appuyer sur ESPACE pour basculer entre PRIX et ERREUR" << std::endl;
+    std::cout << "  Appuyer sur 'H' pour afficher la surface (t, S) en carte de chaleur" << std::endl;
+    std::cout << "  Appuyer sur 'G' pour passer de PRIX à ERREUR puis DELTA sur la carte" << std::endl;
+    std::cout << "  Appuyer sur 'R' pour relancer la résolution en affichant la carte au fil des pas" << std::endl;
 
     double K = 100.0; 
     double L = 300.0;
@@ -88,7 +156,15 @@ int main() {
     std::vector<Uint8> colorCyan(3);  colorCyan[0]=0;  colorCyan[1]=255;  colorCyan[2]=255;
     std::vector<Uint8> colorYellow(3);colorYellow[0]=255; colorYellow[1]=255; colorYellow[2]=0;
 
+    // surfaces complètes (t, S) de Crank-Nicolson pour la carte de chaleur
+    std::vector< std::vector<double> > err_surf_call = error_surface(solver_c_call.get_surface(), s, edp_call, true);
+    std::vector< std::vector<double> > err_surf_put = error_surface(solver_c_put.get_surface(), s, edp_put, false);
+    std::vector< std::vector<double> > delta_surf_call = delta_surface(solver_c_call.get_surface(), L / N);
+    std::vector< std::vector<double> > delta_surf_put = delta_surface(solver_c_put.get_surface(), L / N);
+    Heatmap heatmap(renderer, 640, 480);
+
     bool quit = false; SDL_Event e; int option_type = 1; int view_mode = 1;
+    bool show_heatmap = false; int heatmap_field = 0; bool heatmap_dirty = true;
 
     while (!quit) {
         while (SDL_PollEvent(&e)) {
@@ -97,12 +173,43 @@ int main() {
                 if (e.key.keysym.sym == SDLK_c) option_type = 1;
                 if (e.key.keysym.sym == SDLK_p) option_type = 2;
                 if (e.key.keysym.sym == SDLK_SPACE) view_mode = (view_mode == 1) ? 2 : 1;
+                if (e.key.keysym.sym == SDLK_h) show_heatmap = !show_heatmap;
+                if (e.key.keysym.sym == SDLK_g) heatmap_field = (heatmap_field + 1) % 3;
+                if (e.key.keysym.sym == SDLK_c || e.key.keysym.sym == SDLK_p || e.key.keysym.sym == SDLK_h
+                    || e.key.keysym.sym == SDLK_g) heatmap_dirty = true;
+                if (e.key.keysym.sym == SDLK_r && show_heatmap) {
+                    // nouvelle résolution du prix : la carte se remplit ligne par ligne, de t=T vers t=0
+                    Cranck_nicolson& solver = (option_type == 1) ? solver_c_call : solver_c_put;
+                    // la plage de la solution précédente sert d'échelle ; les lignes pas encore calculées restent noires
+                    heatmap_field = 0;
+                    heatmap.fit_range(solver.get_surface(), 0, M + 1);
+                    heatmap.clear();
+                    Live_view view = {&heatmap, &solver, renderer};
+                    solver.set_progress_callback(live_progress, &view, 8);
+                    solver.solve();
+                    solver.set_progress_callback(nullptr, nullptr);
+                    // texture reconstruite depuis la nouvelle surface, une fois la résolution terminée
+                    heatmap.fit_range(solver.get_surface(), 0, M + 1);
+                    heatmap.update(solver.get_surface());
+                    heatmap_dirty = false;
+                }
             }
         }
         SDL_SetRenderDrawColor(renderer, 0, 0, 0, 255);
         SDL_RenderClear(renderer);
 
-        if (option_type == 1) {
+        if (show_heatmap) {
+            if (heatmap_dirty) {
+                const std::vector< std::vector<double> >* field;
+                if (heatmap_field == 0) field = (option_type == 1) ? &solver_c_call.get_surface() : &solver_c_put.get_surface();
+                else if (heatmap_field == 1) field = (option_type == 1) ? &err_surf_call : &err_surf_put;
+                else field = (option_type == 1) ? &delta_surf_call : &delta_surf_put;
+                heatmap.fit_range(*field, 0, M + 1);
+                heatmap.update(*field);
+                heatmap_dirty = false;
+            }
+            heatmap.draw();
+        } else if (option_type == 1) {
             if (view_mode == 1) {
                 graphique.draw_curve(s, res_call_comp, colorGreen);
                 graphique.draw_curve(s, res_call_red_aligned,  colorCyan);
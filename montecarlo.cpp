@@ -0,0 +1,292 @@
+/**
+ * @file montecarlo.cpp
+ * @author Mathias LE BOUEDEC - Lilou MALFOY
+ * @date 2025
+ * @brief Implémentation du moteur Monte-Carlo multi-thread (générateur Philox à compteur)
+ */
+
+#include "montecarlo.hpp"
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+#include <thread>
+
+
+/**
+ * @brief Constructeur du générateur
+ * @param seed Graine sur 64 bits
+ */
+Philox::Philox(uint64_t seed) {
+    key_[0] = static_cast<uint32_t>(seed);
+    key_[1] = static_cast<uint32_t>(seed >> 32);
+}
+
+/**
+ * @brief Applique les 10 tours de Philox à un compteur
+ * @param ctr Compteur de 128 bits (4 mots de 32 bits), remplacé par la sortie
+ */
+void Philox::operator()(uint32_t ctr[4]) const {
+    const uint32_t M0 = 0xD2511F53u, M1 = 0xCD9E8D57u; //multiplicateurs de Philox4x32
+    const uint32_t W0 = 0x9E3779B9u, W1 = 0xBB67AE85u; //incréments de la clé (constantes de Weyl)
+    uint32_t k0 = key_[0], k1 = key_[1];
+
+    for (int round = 0; round < 10; ++round) {
+        uint64_t p0 = static_cast<uint64_t>(M0) * ctr[0];
+        uint64_t p1 = static_cast<uint64_t>(M1) * ctr[2];
+        uint32_t hi0 = static_cast<uint32_t>(p0 >> 32), lo0 = static_cast<uint32_t>(p0);
+        uint32_t hi1 = static_cast<uint32_t>(p1 >> 32), lo1 = static_cast<uint32_t>(p1);
+        uint32_t c1 = ctr[1], c3 = ctr[3];
+        ctr[0] = hi1 ^ c1 ^ k0;
+        ctr[1] = lo1;
+        ctr[2] = hi0 ^ c3 ^ k1;
+        ctr[3] = lo0;
+        k0 += W0;
+        k1 += W1;
+    }
+}
+
+/**
+ * @brief Deux tirages gaussiens indépendants (Box-Muller) pour une trajectoire et un indice de tirage
+ * @param path Indice de la trajectoire
+ * @param draw Indice du tirage dans la trajectoire
+ * @param z1 Premier tirage N(0,1)
+ * @param z2 Second tirage N(0,1)
+ */
+void Philox::normal_pair(uint64_t path, uint32_t draw, double& z1, double& z2) const {
+    uint32_t ctr[4] = { static_cast<uint32_t>(path), static_cast<uint32_t>(path >> 32), draw, 0u };
+    (*this)(ctr);
+
+    //deux uniformes sur 53 bits dans ]0,1]
+    const double inv53 = 1.0 / 9007199254740992.0;
+    double u1 = (static_cast<double>((static_cast<uint64_t>(ctr[0]) << 21) ^ (ctr[1] >> 11)) + 1.0) * inv53;
+    double u2 = static_cast<double>((static_cast<uint64_t>(ctr[2]) << 21) ^ (ctr[3] >> 11)) * inv53;
+
+    const double two_pi = 6.283185307179586476925;
+    double rho = std::sqrt(-2.0 * std::log(u1));
+    z1 = rho * std::cos(two_pi * u2);
+    z2 = rho * std::sin(two_pi * u2);
+}
+
+
+/**
+ * @brief Constructeur de la classe Monte_carlo
+ * @param edp Référence vers l'EDP (option et paramètres du marché, structure par terme de r et sigma comprise)
+ * @param n_paths Nombre de trajectoires (arrondi au pair supérieur en antithétique)
+ * @param n_steps Nombre de pas de temps pour les payoffs dépendant du chemin
+ * @param seed Graine du générateur
+ * @param n_threads Nombre de threads (0 : nombre de coeurs disponibles)
+ */
+Monte_carlo::Monte_carlo(EDP& edp, long n_paths, int n_steps, uint64_t seed, int n_threads)
+    : edp_(edp), n_paths_(n_paths), n_steps_(std::max(n_steps, 1)), seed_(seed), n_threads_(n_threads),
+      antithetic_(false), control_(CONTROL_NONE), control_price_(0.0) {
+    if (n_threads_ <= 0) {
+        n_threads_ = std::max(1, static_cast<int>(std::thread::hardware_concurrency()));
+    }
+}
+
+/**
+ * @brief Active ou désactive les variables antithétiques
+ *
+ * Les trajectoires sont simulées par paires : un nombre impair de trajectoires est arrondi
+ * au pair supérieur (MC_result::n_paths donne le nombre réellement simulé).
+ * @param on true pour activer
+ */
+void Monte_carlo::set_antithetic(bool on) {
+    antithetic_ = on;
+}
+
+/**
+ * @brief Active la variable de contrôle S_T actualisé, d'espérance exacte S0
+ */
+void Monte_carlo::set_spot_control_variate() {
+    control_ = CONTROL_SPOT;
+}
+
+/**
+ * @brief Active la variable de contrôle : le payoff européen de l'option actualisé
+ * @param reference_price Prix exact de ce payoff (formule fermée ou solveur EDP)
+ * @throw std::invalid_argument si l'option ne dépend pas du chemin
+ */
+void Monte_carlo::set_control_variate(double reference_price) {
+    if (!edp_.getOption()->is_path_dependent()) {
+        throw std::invalid_argument("Monte_carlo : le contrôle européen d'une option européenne est l'option elle-même");
+    }
+    control_ = CONTROL_EUROPEAN;
+    control_price_ = reference_price;
+}
+
+/**
+ * @brief Désactive la variable de contrôle
+ */
+void Monte_carlo::clear_control_variate() {
+    control_ = CONTROL_NONE;
+}
+
+/**
+ * @brief Simule un bloc de trajectoires
+ * @param S0 Prix initial de l'actif
+ * @param block Indice du bloc
+ * @param sums Sommes partielles du bloc
+ */
+void Monte_carlo::simulate_block(double S0, long block, Block_sums& sums) const {
+    const Option* option = edp_.getOption();
+    const Philox rng(seed_);
+    const bool path_dep = option->is_path_dependent();
+    const double r = edp_.getR();
+    const double sigma = edp_.getSigma();
+    const double T = edp_.getT();
+    const double disc = std::exp(-r * T); //r moyen : exp(-r T) est aussi l'actualisation de la courbe
+
+    //un échantillon = une trajectoire, ou une paire de trajectoires en antithétique (n_paths impair arrondi au pair supérieur)
+    const long n_samples = antithetic_ ? (n_paths_ + 1) / 2 : n_paths_;
+    const long first = block * block_size;
+    const long nb = std::min(block_size, n_samples - first);
+
+    const int steps = path_dep ? n_steps_ : 1; //un seul pas exact suffit pour un payoff européen
+    const double dt = T / steps;
+    //dérive et écart-type de ln S sur chaque pas ; avec une structure par terme, intégrales exactes de r(t) et
+    //sigma(t)^2 sur le pas (la probabilité de toucher une barrière dépend de la forme de sigma(t), pas de sa moyenne)
+    std::vector<double> mu(steps, (r - 0.5 * sigma * sigma) * dt), vol(steps, sigma * std::sqrt(dt));
+    if (edp_.has_term_structure()) {
+        for (int k = 0; k < steps; ++k) {
+            double tau_begin = T - k * dt, tau_end = (k + 1 == steps) ? 0.0 : T - (k + 1) * dt;
+            double variance = edp_.variance_integral(tau_begin) - edp_.variance_integral(tau_end);
+            mu[k] = edp_.rate_integral(tau_begin) - edp_.rate_integral(tau_end) - 0.5 * variance;
+            vol[k] = std::sqrt(variance);
+        }
+    }
+
+    //stockage par colonnes (pas de temps x trajectoires) pour des boucles vectorisables
+    std::vector<double> z(nb), z_next(nb);
+    std::vector<double> lnS(nb, std::log(S0)), lnA(nb, std::log(S0));
+    std::vector<double> paths, paths_anti;
+    if (path_dep) {
+        paths.assign(static_cast<std::size_t>(steps + 1) * nb, S0);
+        if (antithetic_) paths_anti.assign(static_cast<std::size_t>(steps + 1) * nb, S0);
+    }
+
+    for (int k = 0; k < steps; ++k) {
+        //tirages : un appel Philox fournit les normales des pas k et k+1
+        if (k % 2 == 0) {
+            for (long p = 0; p < nb; ++p) {
+                rng.normal_pair(static_cast<uint64_t>(first + p), static_cast<uint32_t>(k / 2), z[p], z_next[p]);
+            }
+        } else {
+            z.swap(z_next);
+        }
+
+        //évolution log-normale exacte sur le pas
+        const double mu_k = mu[k], vol_k = vol[k];
+        for (long p = 0; p < nb; ++p) {
+            lnS[p] += mu_k + vol_k * z[p];
+            lnA[p] += mu_k - vol_k * z[p];
+        }
+
+        if (path_dep) {
+            double* col = &paths[static_cast<std::size_t>(k + 1) * nb];
+            for (long p = 0; p < nb; ++p) col[p] = std::exp(lnS[p]);
+            if (antithetic_) {
+                double* col_a = &paths_anti[static_cast<std::size_t>(k + 1) * nb];
+                for (long p = 0; p < nb; ++p) col_a[p] = std::exp(lnA[p]);
+            }
+        }
+    }
+
+    sums.n = nb;
+    sums.sx = sums.sxx = sums.sy = sums.syy = sums.sxy = 0.0;
+    std::vector<double> path(steps + 1);
+
+    //contrôle : S_T, ou le payoff européen (jamais l'option elle-même, refusé par set_control_variate)
+    const bool spot_control = control_ != CONTROL_EUROPEAN;
+    for (long p = 0; p < nb; ++p) {
+        double ST = std::exp(lnS[p]);
+        double x, y = spot_control ? ST : option->payoff(ST);
+        if (path_dep) {
+            for (int k = 0; k <= steps; ++k) path[k] = paths[static_cast<std::size_t>(k) * nb + p];
+            x = option->payoff_path(path);
+        } else {
+            x = option->payoff(ST);
+        }
+
+        if (antithetic_) {
+            double ST_a = std::exp(lnA[p]);
+            double y_a = spot_control ? ST_a : option->payoff(ST_a), x_a;
+            if (path_dep) {
+                for (int k = 0; k <= steps; ++k) path[k] = paths_anti[static_cast<std::size_t>(k) * nb + p];
+                x_a = option->payoff_path(path);
+            } else {
+                x_a = option->payoff(ST_a);
+            }
+            x = 0.5 * (x + x_a);
+            y = 0.5 * (y + y_a);
+        }
+
+        x *= disc;
+        y *= disc;
+        sums.sx += x;
+        sums.sxx += x * x;
+        sums.sy += y;
+        sums.syy += y * y;
+        sums.sxy += x * y;
+    }
+}
+
+/**
+ * @brief Calcule le prix de l'option à t=0
+ * @param S0 Prix initial de l'actif
+ * @return Prix estimé, erreur standard et nombre d'échantillons
+ */
+MC_result Monte_carlo::price(double S0) const {
+    const long n_samples = antithetic_ ? (n_paths_ + 1) / 2 : n_paths_;
+    const long n_blocks = (n_samples + block_size - 1) / block_size;
+    std::vector<Block_sums> blocks(n_blocks);
+
+    //répartition statique des blocs : le résultat d'un bloc ne dépend pas du thread
+    int n_threads = static_cast<int>(std::min<long>(n_threads_, std::max(n_blocks, 1L)));
+    std::vector<std::thread> workers;
+    for (int id = 0; id < n_threads; ++id) {
+        workers.push_back(std::thread([this, S0, id, n_threads, n_blocks, &blocks]() {
+            for (long b = id; b < n_blocks; b += n_threads) simulate_block(S0, b, blocks[b]);
+        }));
+    }
+    for (std::size_t i = 0; i < workers.size(); ++i) workers[i].join();
+
+    //réduction dans l'ordre des blocs : résultat identique bit à bit quel que soit le nombre de threads
+    double sx = 0.0, sxx = 0.0, sy = 0.0, syy = 0.0, sxy = 0.0;
+    for (long b = 0; b < n_blocks; ++b) {
+        sx += blocks[b].sx;
+        sxx += blocks[b].sxx;
+        sy += blocks[b].sy;
+        syy += blocks[b].syy;
+        sxy += blocks[b].sxy;
+    }
+
+    MC_result res;
+    res.n_samples = n_samples;
+    res.n_paths = antithetic_ ? 2 * n_samples : n_samples;
+    res.beta = 0.0;
+    if (n_samples == 0) {
+        res.price = 0.0;
+        res.std_error = 0.0;
+        return res;
+    }
+
+    double n = static_cast<double>(n_samples);
+    double mx = sx / n, my = sy / n;
+    double var_x = std::max(sxx / n - mx * mx, 0.0);
+    double var_y = std::max(syy / n - my * my, 0.0);
+    double cov = sxy / n - mx * my;
+    double var = var_x;
+    res.price = mx;
+
+    if (control_ != CONTROL_NONE && var_y > 0.0) {
+        //estimateur à variable de contrôle : X - beta (Y - E[Y]), E[e^{-rT} S_T] = S0
+        double mean_y = (control_ == CONTROL_SPOT) ? S0 : control_price_;
+        res.beta = cov / var_y;
+        res.price = mx - res.beta * (my - mean_y);
+        var = std::max(var_x - cov * cov / var_y, 0.0);
+    }
+
+    res.std_error = (n_samples > 1) ? std::sqrt(var * n / (n - 1.0) / n) : 0.0;
+    return res;
+}
@@ -0,0 +1,153 @@
+/**
+ * @file montecarlo.hpp
+ * @author Mathias LE BOUEDEC - Lilou MALFOY
+ * @date 2025
+ * @brief Définition du moteur Monte-Carlo multi-thread (générateur Philox à compteur)
+ */
+
+#ifndef MONTECARLO_HPP
+#define MONTECARLO_HPP
+
+#include "edp.hpp"
+#include <cstdint>
+#include <vector>
+
+
+/**
+ * @brief Générateur pseudo-aléatoire Philox4x32-10 basé sur un compteur
+ *
+ * Le tirage ne dépend que de (graine, compteur) : chaque trajectoire possède son
+ * propre flux, indépendamment du thread qui la simule.
+ */
+class Philox {
+private:
+    uint32_t key_[2]; // clé dérivée de la graine
+
+public:
+    /**
+     * @brief Constructeur du générateur
+     * @param seed Graine sur 64 bits
+     */
+    explicit Philox(uint64_t seed);
+
+    /**
+     * @brief Applique les 10 tours de Philox à un compteur
+     * @param ctr Compteur de 128 bits (4 mots de 32 bits), remplacé par la sortie
+     */
+    void operator()(uint32_t ctr[4]) const;
+
+    /**
+     * @brief Deux tirages gaussiens indépendants (Box-Muller) pour une trajectoire et un indice de tirage
+     * @param path Indice de la trajectoire
+     * @param draw Indice du tirage dans la trajectoire
+     * @param z1 Premier tirage N(0,1)
+     * @param z2 Second tirage N(0,1)
+     */
+    void normal_pair(uint64_t path, uint32_t draw, double& z1, double& z2) const;
+};
+
+
+/**
+ * @brief Variable de contrôle Y de l'estimateur X - beta (Y - E[Y])
+ */
+enum Control_variate {
+    CONTROL_NONE,     // pas de contrôle
+    CONTROL_SPOT,     // S_T actualisé, d'espérance exacte S0 (toutes les options)
+    CONTROL_EUROPEAN  // payoff européen de l'option actualisé, de prix fourni (options dépendant du chemin seulement)
+};
+
+
+/**
+ * @brief Résultat d'une évaluation Monte-Carlo
+ */
+struct MC_result {
+    double price;     // estimation du prix
+    double std_error; // erreur standard de l'estimateur
+    long n_samples;   // nombre d'échantillons indépendants (paires si antithétique)
+    long n_paths;     // trajectoires simulées (nombre demandé arrondi au pair supérieur en antithétique)
+    double beta;      // coefficient de la variable de contrôle (0 si inactive)
+};
+
+
+/**
+ * @brief Moteur Monte-Carlo pour les options décrites par une EDP
+ */
+class Monte_carlo {
+private:
+    EDP& edp_;          // Référence vers l'EDP (option, sigma, r, T)
+    long n_paths_;      // Nombre de trajectoires
+    int n_steps_;       // Nombre de pas de temps (options dépendantes du chemin)
+    uint64_t seed_;     // Graine du générateur
+    int n_threads_;     // Nombre de threads
+    bool antithetic_;   // Variables antithétiques
+    Control_variate control_; // Variable de contrôle
+    double control_price_; // Prix exact du payoff européen servant de contrôle (CONTROL_EUROPEAN)
+
+    static const long block_size = 4096; // taille fixe des blocs (garantit la reproductibilité)
+
+    /**
+     * @brief Sommes partielles d'un bloc de trajectoires
+     */
+    struct Block_sums {
+        long n;
+        double sx, sxx, sy, syy, sxy;
+    };
+
+    /**
+     * @brief Simule un bloc de trajectoires
+     * @param S0 Prix initial de l'actif
+     * @param block Indice du bloc
+     * @param sums Sommes partielles du bloc
+     */
+    void simulate_block(double S0, long block, Block_sums& sums) const;
+
+public:
+    /**
+     * @brief Constructeur de la classe Monte_carlo
+     * @param edp Référence vers l'EDP (option et paramètres du marché, structure par terme de r et sigma comprise)
+     * @param n_paths Nombre de trajectoires (arrondi au pair supérieur en antithétique)
+     * @param n_steps Nombre de pas de temps pour les payoffs dépendant du chemin
+     * @param seed Graine du générateur
+     * @param n_threads Nombre de threads (0 : nombre de coeurs disponibles)
+     */
+    Monte_carlo(EDP& edp, long n_paths, int n_steps = 1, uint64_t seed = 2025, int n_threads = 0);
+
+    /**
+     * @brief Active ou désactive les variables antithétiques
+     *
+     * Les trajectoires sont simulées par paires : un nombre impair de trajectoires est arrondi
+     * au pair supérieur (MC_result::n_paths donne le nombre réellement simulé).
+     * @param on true pour activer
+     */
+    void set_antithetic(bool on);
+
+    /**
+     * @brief Active la variable de contrôle S_T actualisé, d'espérance exacte S0
+     */
+    void set_spot_control_variate();
+
+    /**
+     * @brief Active la variable de contrôle : le payoff européen de l'option actualisé
+     *
+     * Réservé aux options dépendant du chemin : pour une option européenne ce contrôle est l'option
+     * elle-même (beta = 1, erreur nulle, prix égal à la référence).
+     * @param reference_price Prix exact de ce payoff (formule fermée ou solveur EDP)
+     * @throw std::invalid_argument si l'option ne dépend pas du chemin
+     */
+    void set_control_variate(double reference_price);
+
+    /**
+     * @brief Désactive la variable de contrôle
+     */
+    void clear_control_variate();
+
+    /**
+     * @brief Calcule le prix de l'option à t=0
+     * @param S0 Prix initial de l'actif
+     * @return Prix estimé, erreur standard et nombre d'échantillons
+     */
+    MC_result price(double S0) const;
+};
+
+
+#endif // MONTECARLO_HPP
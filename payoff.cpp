@@ -24,6 +24,134 @@ Option::Option(double K, double L, double r, double T)
  */
 Option::~Option() {} 
 
+/**
+ * @brief Payoff d'une trajectoire complète (options dépendantes du chemin)
+ * @param path Prix de l'actif aux dates d'observation, de t=0 jusqu'à T
+ * @return Valeur du payoff, par défaut le payoff européen au dernier point
+ */
+double Option::payoff_path(const std::vector<double>& path) const {
+    return payoff(path.back());
+}
+
+/**
+ * @brief Indique si le payoff dépend de toute la trajectoire
+ * @return false par défaut (option européenne)
+ */
+bool Option::is_path_dependent() const {
+    return false;
+}
+
+/**
+ * @brief Points où le payoff n'est pas régulier (coude ou discontinuité)
+ * @return Liste des points singuliers, par défaut le strike
+ */
+std::vector<double> Option::singular_points() const {
+    return std::vector<double>(1, K_);
+}
+
+/**
+ * @brief Condition à la limite basse actualisée avec la courbe de taux de l'EDP
+ * @param L Prix au bord
+ * @param t Temps
+ * @param rate Courbe de taux de l'EDP, 0 pour le taux constant de l'option
+ * @return boundary_condition_low(L, t) par défaut sans courbe
+ */
+double Option::boundary_condition_low(double L, double t, const Piecewise_curve* rate) const {
+    if (rate != nullptr) throw std::invalid_argument("Option : courbe de taux non prise en charge par cette option");
+    return boundary_condition_low(L, t);
+}
+
+/**
+ * @brief Condition à la limite haute actualisée avec la courbe de taux de l'EDP
+ * @param L Prix au bord
+ * @param t Temps
+ * @param rate Courbe de taux de l'EDP, 0 pour le taux constant de l'option
+ * @return boundary_condition_high(L, t) par défaut sans courbe
+ */
+double Option::boundary_condition_high(double L, double t, const Piecewise_curve* rate) const {
+    if (rate != nullptr) throw std::invalid_argument("Option : courbe de taux non prise en charge par cette option");
+    return boundary_condition_high(L, t);
+}
+
+/**
+ * @brief Dérivée de la condition à la limite basse par rapport au taux r (méthode adjointe)
+ * @param L Prix au bord
+ * @param t Temps
+ * @return d(boundary_condition_low)/dr, 0 par défaut
+ */
+double Option::boundary_condition_low_dr(double /*L*/, double /*t*/) const {
+    return 0.0;
+}
+
+/**
+ * @brief Dérivée de la condition à la limite basse par rapport à un décalage parallèle de la courbe de taux
+ * @param L Prix au bord
+ * @param t Temps
+ * @param rate Courbe de taux de l'EDP, 0 pour le taux constant de l'option
+ * @return d(boundary_condition_low)/dr, boundary_condition_low_dr(L, t) par défaut sans courbe
+ */
+double Option::boundary_condition_low_dr(double L, double t, const Piecewise_curve* rate) const {
+    if (rate != nullptr) throw std::invalid_argument("Option : courbe de taux non prise en charge par cette option");
+    return boundary_condition_low_dr(L, t);
+}
+
+/**
+ * @brief Dérivée de la condition à la limite haute par rapport au taux r (méthode adjointe)
+ * @param L Prix au bord
+ * @param t Temps
+ * @return d(boundary_condition_high)/dr, 0 par défaut
+ */
+double Option::boundary_condition_high_dr(double /*L*/, double /*t*/) const {
+    return 0.0;
+}
+
+/**
+ * @brief Dérivée de la condition à la limite haute par rapport à un décalage parallèle de la courbe de taux
+ * @param L Prix au bord
+ * @param t Temps
+ * @param rate Courbe de taux de l'EDP, 0 pour le taux constant de l'option
+ * @return d(boundary_condition_high)/dr, boundary_condition_high_dr(L, t) par défaut sans courbe
+ */
+double Option::boundary_condition_high_dr(double L, double t, const Piecewise_curve* rate) const {
+    if (rate != nullptr) throw std::invalid_argument("Option : courbe de taux non prise en charge par cette option");
+    return boundary_condition_high_dr(L, t);
+}
+
+/**
+ * @brief Facteur d'actualisation de T à t
+ * @param t Temps
+ * @param rate Courbe de taux de l'EDP, 0 pour le taux constant de l'option
+ * @return exp(-r (T - t)), ou exp(-intégrale de r(s) sur [t, T]) avec une courbe de taux
+ */
+double Option::discount(double t, const Piecewise_curve* rate) const {
+    if (!rate) return std::exp(-r_ * (T_ - t));
+    return std::exp(-rate->integral(t, T_));
+}
+
+/**
+ * @brief Barrière haute désactivante (le domaine de calcul s'arrête à la barrière)
+ * @return Niveau de la barrière, +infini par défaut
+ */
+double Option::upper_barrier() const {
+    return std::numeric_limits<double>::infinity();
+}
+
+/**
+ * @brief Getter pour le strike
+ * @return Strike de l'option
+ */
+double Option::getK() const {
+    return K_;
+}
+
+/**
+ * @brief Getter pour le temps terminal
+ * @return Temps terminal
+ */
+double Option::getT() const {
+    return T_;
+}
+
 /**
  * @brief Constructeur de la classe Call
  * @param K Strike de l'option
@@ -43,22 +171,63 @@ double Call::payoff(double S) const {
     return std::max(S - K_, 0.0);
 }
 
+/**
+ * @brief Méthode pour la condition aux limites basse au taux constant de l'option
+ * @param t Temps
+ * @return Valeur de la condition aux limites basse S=0
+ */
+double Call::boundary_condition_low(double L, double t) const {
+    return boundary_condition_low(L, t, nullptr);
+}
+
 /**
  * @brief Méthode pour la condition aux limites basse
  * @param t Temps
+ * @param rate Courbe de taux de l'EDP, 0 pour le taux constant de l'option
  * @return Valeur de la condition aux limites basse S=0
  */
-double Call::boundary_condition_low(double /*L*/, double /*t*/) const { 
+double Call::boundary_condition_low(double /*L*/, double /*t*/, const Piecewise_curve* /*rate*/) const { 
     return 0.0; 
 }
 
+/**
+ * @brief Méthode pour la condition aux limites haute au taux constant de l'option
+ * @param t Temps
+ * @return Valeur de la condition aux limites haute S=L
+ */
+double Call::boundary_condition_high(double L, double t) const {
+    return boundary_condition_high(L, t, nullptr);
+}
+
 /**
  * @brief Méthode pour la condition aux limites haute
  * @param t Temps
+ * @param rate Courbe de taux de l'EDP, 0 pour le taux constant de l'option
  * @return Valeur de la condition aux limites haute S=L
  */
-double Call::boundary_condition_high(double L, double t) const { 
-    return L - K_ * std::exp(-r_ * (t -T_));
+double Call::boundary_condition_high(double L, double t, const Piecewise_curve* rate) const { 
+    return L - K_ * discount(t, rate);
+}
+
+/**
+ * @brief Dérivée de la condition à la limite haute par rapport à r au taux constant de l'option
+ * @param L Prix au bord
+ * @param t Temps
+ * @return d(boundary_condition_high)/dr
+ */
+double Call::boundary_condition_high_dr(double L, double t) const {
+    return boundary_condition_high_dr(L, t, nullptr);
+}
+
+/**
+ * @brief Dérivée de la condition à la limite haute par rapport à r
+ * @param L Prix au bord
+ * @param t Temps
+ * @param rate Courbe de taux de l'EDP, 0 pour le taux constant de l'option
+ * @return d(boundary_condition_high)/dr
+ */
+double Call::boundary_condition_high_dr(double /*L*/, double t, const Piecewise_curve* rate) const {
+    return K_ * (T_ - t) * discount(t, rate);
 }
 
 /**
@@ -80,20 +249,316 @@ double Put::payoff(double S) const {
     return std::max(K_ - S, 0.0);  
 }
 
+/**
+ * @brief Méthode pour la condition aux limites basse (valeur asymptotique K e^{-r(T-t)} - S) au taux constant de l'option
+ * @param L Prix au bord bas (0 : K e^{-r(T-t)} ; borne tronquée s_low > 0 en log-prix)
+ * @param t Temps
+ * @return Valeur de la condition aux limites basse S=L
+ */
+double Put::boundary_condition_low(double L, double t) const {
+    return boundary_condition_low(L, t, nullptr);
+}
+
+/**
+ * @brief Méthode pour la condition aux limites basse (valeur asymptotique K e^{-r(T-t)} - S)
+ * @param L Prix au bord bas (0 : K e^{-r(T-t)} ; borne tronquée s_low > 0 en log-prix)
+ * @param t Temps
+ * @param rate Courbe de taux de l'EDP, 0 pour le taux constant de l'option
+ * @return Valeur de la condition aux limites basse S=L
+ */
+double Put::boundary_condition_low(double L, double t, const Piecewise_curve* rate) const { 
+    return std::max(K_ * discount(t, rate) - L, 0.0); 
+}
+
+/**
+ * @brief Méthode pour la condition aux limites haute au taux constant de l'option
+ * @param t Temps
+ * @return Valeur de la condition aux limites haute S=L
+ */
+double Put::boundary_condition_high(double L, double t) const {
+    return boundary_condition_high(L, t, nullptr);
+}
+
+/**
+ * @brief Méthode pour la condition aux limites haute
+ * @param t Temps
+ * @param rate Courbe de taux de l'EDP, 0 pour le taux constant de l'option
+ * @return Valeur de la condition aux limites haute S=L
+ */
+double Put::boundary_condition_high(double /*L*/, double /*t*/, const Piecewise_curve* /*rate*/) const { 
+    return 0.0;
+}
+
+/**
+ * @brief Dérivée de la condition à la limite basse par rapport à r au taux constant de l'option
+ * @param L Prix au bord
+ * @param t Temps
+ * @return d(boundary_condition_low)/dr
+ */
+double Put::boundary_condition_low_dr(double L, double t) const {
+    return boundary_condition_low_dr(L, t, nullptr);
+}
+
+/**
+ * @brief Dérivée de la condition à la limite basse par rapport à r
+ * @param L Prix au bord
+ * @param t Temps
+ * @param rate Courbe de taux de l'EDP, 0 pour le taux constant de l'option
+ * @return d(boundary_condition_low)/dr
+ */
+double Put::boundary_condition_low_dr(double L, double t, const Piecewise_curve* rate) const {
+    if (K_ * discount(t, rate) <= L) return 0.0;
+    return -K_ * (T_ - t) * discount(t, rate);
+}
+
+/**
+ * @brief Constructeur de la classe Digital_call
+ * @param K Strike de l'option
+ * @param L Valeur maximale de l'actif sous-jacent
+ * @param r Taux d'intérêt sans risque
+ * @param T Temps terminal
+ */
+Digital_call::Digital_call(double K, double L, double r, double T)
+    : Option(K, L, r, T) {}
+
+/**
+ * @brief Méthode pour le payoff de l'option digitale
+ * @param S Prix de l'actif sous-jacent
+ * @return 1 si S > K, 0 sinon
+ */
+double Digital_call::payoff(double S) const {
+    return (S > K_) ? 1.0 : 0.0;
+}
+
+/**
+ * @brief Méthode pour la condition aux limites basse au taux constant de l'option
+ * @param t Temps
+ * @return Valeur de la condition aux limites basse S=0
+ */
+double Digital_call::boundary_condition_low(double L, double t) const {
+    return boundary_condition_low(L, t, nullptr);
+}
+
 /**
  * @brief Méthode pour la condition aux limites basse
  * @param t Temps
+ * @param rate Courbe de taux de l'EDP, 0 pour le taux constant de l'option
  * @return Valeur de la condition aux limites basse S=0
  */
-double Put::boundary_condition_low(double /*L*/, double t) const { 
-    return 0.0 + K_ * std::exp(-r_ *(T_ - t)); 
+double Digital_call::boundary_condition_low(double /*L*/, double /*t*/, const Piecewise_curve* /*rate*/) const {
+    return 0.0;
+}
+
+/**
+ * @brief Méthode pour la condition aux limites haute au taux constant de l'option
+ * @param t Temps
+ * @return Valeur de la condition aux limites haute S=L (montant actualisé)
+ */
+double Digital_call::boundary_condition_high(double L, double t) const {
+    return boundary_condition_high(L, t, nullptr);
 }
 
 /**
  * @brief Méthode pour la condition aux limites haute
  * @param t Temps
+ * @param rate Courbe de taux de l'EDP, 0 pour le taux constant de l'option
+ * @return Valeur de la condition aux limites haute S=L (montant actualisé)
+ */
+double Digital_call::boundary_condition_high(double /*L*/, double t, const Piecewise_curve* rate) const {
+    return discount(t, rate);
+}
+
+/**
+ * @brief Dérivée de la condition à la limite haute par rapport à r au taux constant de l'option
+ * @param L Prix au bord
+ * @param t Temps
+ * @return d(boundary_condition_high)/dr
+ */
+double Digital_call::boundary_condition_high_dr(double L, double t) const {
+    return boundary_condition_high_dr(L, t, nullptr);
+}
+
+/**
+ * @brief Dérivée de la condition à la limite haute par rapport à r
+ * @param L Prix au bord
+ * @param t Temps
+ * @param rate Courbe de taux de l'EDP, 0 pour le taux constant de l'option
+ * @return d(boundary_condition_high)/dr
+ */
+double Digital_call::boundary_condition_high_dr(double /*L*/, double t, const Piecewise_curve* rate) const {
+    return -(T_ - t) * discount(t, rate);
+}
+
+/**
+ * @brief Constructeur de la classe Digital_put
+ * @param K Strike de l'option
+ * @param L Valeur maximale de l'actif sous-jacent
+ * @param r Taux d'intérêt sans risque
+ * @param T Temps terminal
+ */
+Digital_put::Digital_put(double K, double L, double r, double T)
+    : Option(K, L, r, T) {}
+
+/**
+ * @brief Méthode pour le payoff de l'option digitale
+ * @param S Prix de l'actif sous-jacent
+ * @return 1 si S < K, 0 sinon
+ */
+double Digital_put::payoff(double S) const {
+    return (S < K_) ? 1.0 : 0.0;
+}
+
+/**
+ * @brief Méthode pour la condition aux limites basse au taux constant de l'option
+ * @param t Temps
+ * @return Valeur de la condition aux limites basse S=0 (montant actualisé)
+ */
+double Digital_put::boundary_condition_low(double L, double t) const {
+    return boundary_condition_low(L, t, nullptr);
+}
+
+/**
+ * @brief Méthode pour la condition aux limites basse
+ * @param t Temps
+ * @param rate Courbe de taux de l'EDP, 0 pour le taux constant de l'option
+ * @return Valeur de la condition aux limites basse S=0 (montant actualisé)
+ */
+double Digital_put::boundary_condition_low(double /*L*/, double t, const Piecewise_curve* rate) const {
+    return discount(t, rate);
+}
+
+/**
+ * @brief Méthode pour la condition aux limites haute au taux constant de l'option
+ * @param t Temps
  * @return Valeur de la condition aux limites haute S=L
  */
-double Put::boundary_condition_high(double /*L*/, double /*t*/) const { 
+double Digital_put::boundary_condition_high(double L, double t) const {
+    return boundary_condition_high(L, t, nullptr);
+}
+
+/**
+ * @brief Méthode pour la condition aux limites haute
+ * @param t Temps
+ * @param rate Courbe de taux de l'EDP, 0 pour le taux constant de l'option
+ * @return Valeur de la condition aux limites haute S=L
+ */
+double Digital_put::boundary_condition_high(double /*L*/, double /*t*/, const Piecewise_curve* /*rate*/) const {
+    return 0.0;
+}
+
+/**
+ * @brief Dérivée de la condition à la limite basse par rapport à r au taux constant de l'option
+ * @param L Prix au bord
+ * @param t Temps
+ * @return d(boundary_condition_low)/dr
+ */
+double Digital_put::boundary_condition_low_dr(double L, double t) const {
+    return boundary_condition_low_dr(L, t, nullptr);
+}
+
+/**
+ * @brief Dérivée de la condition à la limite basse par rapport à r
+ * @param L Prix au bord
+ * @param t Temps
+ * @param rate Courbe de taux de l'EDP, 0 pour le taux constant de l'option
+ * @return d(boundary_condition_low)/dr
+ */
+double Digital_put::boundary_condition_low_dr(double /*L*/, double t, const Piecewise_curve* rate) const {
+    return -(T_ - t) * discount(t, rate);
+}
+
+/**
+ * @brief Constructeur de la classe Barrier_up_out_call
+ * @param K Strike de l'option
+ * @param B Barrière haute désactivante
+ * @param L Valeur maximale de l'actif sous-jacent
+ * @param r Taux d'intérêt sans risque
+ * @param T Temps terminal
+ */
+Barrier_up_out_call::Barrier_up_out_call(double K, double B, double L, double r, double T)
+    : Option(K, L, r, T), B_(B) {}
+
+/**
+ * @brief Méthode pour le payoff à maturité (nul au-delà de la barrière)
+ * @param S Prix de l'actif sous-jacent
+ * @return Valeur du payoff
+ */
+double Barrier_up_out_call::payoff(double S) const {
+    return (S < B_) ? std::max(S - K_, 0.0) : 0.0;
+}
+
+/**
+ * @brief Payoff d'une trajectoire : nul si la barrière a été touchée
+ * @param path Prix de l'actif aux dates d'observation
+ * @return Valeur du payoff
+ */
+double Barrier_up_out_call::payoff_path(const std::vector<double>& path) const {
+    for (std::size_t k = 0; k < path.size(); ++k) {
+        if (path[k] >= B_) return 0.0;
+    }
+    return payoff(path.back());
+}
+
+/**
+ * @brief L'option désactivante dépend de la trajectoire
+ * @return true
+ */
+bool Barrier_up_out_call::is_path_dependent() const {
+    return true;
+}
+
+/**
+ * @brief Points singuliers : strike et barrière
+ * @return {K, B}
+ */
+std::vector<double> Barrier_up_out_call::singular_points() const {
+    std::vector<double> pts(1, K_);
+    pts.push_back(B_);
+    return pts;
+}
+
+/**
+ * @brief Barrière haute désactivante
+ * @return B
+ */
+double Barrier_up_out_call::upper_barrier() const {
+    return B_;
+}
+
+/**
+ * @brief Méthode pour la condition aux limites basse au taux constant de l'option
+ * @param t Temps
+ * @return Valeur de la condition aux limites basse S=0
+ */
+double Barrier_up_out_call::boundary_condition_low(double L, double t) const {
+    return boundary_condition_low(L, t, nullptr);
+}
+
+/**
+ * @brief Méthode pour la condition aux limites basse
+ * @param t Temps
+ * @param rate Courbe de taux de l'EDP, 0 pour le taux constant de l'option
+ * @return Valeur de la condition aux limites basse S=0
+ */
+double Barrier_up_out_call::boundary_condition_low(double /*L*/, double /*t*/, const Piecewise_curve* /*rate*/) const {
     return 0.0;
-}
\ No newline at end of file
+}
+
+/**
+ * @brief Méthode pour la condition aux limites haute (sur la barrière) au taux constant de l'option
+ * @param t Temps
+ * @return Valeur de la condition aux limites haute S=B : l'option est désactivée
+ */
+double Barrier_up_out_call::boundary_condition_high(double L, double t) const {
+    return boundary_condition_high(L, t, nullptr);
+}
+
+/**
+ * @brief Méthode pour la condition aux limites haute (sur la barrière)
+ * @param t Temps
+ * @param rate Courbe de taux de l'EDP, 0 pour le taux constant de l'option
+ * @return Valeur de la condition aux limites haute S=B : l'option est désactivée
+ */
+double Barrier_up_out_call::boundary_condition_high(double /*L*/, double /*t*/, const Piecewise_curve* /*rate*/) const {
+    return 0.0;
+}
@@ -11,6 +11,9 @@
 #include<algorithm>
 #include<cmath>
 #include<stdexcept>
+#include<vector>
+#include<limits>
+#include "term_structure.hpp"
 
 
 /**
@@ -24,6 +27,14 @@ class Option{
         double r_; //taux d'intérêt sans risque
         double T_; //temps terminal
 
+        /**
+        * @brief Facteur d'actualisation de T à t
+        * @param t Temps
+        * @param rate Courbe de taux de l'EDP, 0 pour le taux constant de l'option
+        * @return exp(-r (T - t)), ou exp(-intégrale de r(s) sur [t, T]) avec une courbe de taux
+        */
+        double discount(double t, const Piecewise_curve* rate) const;
+
     public:
         /**
         * @brief Constructeur de la classe Option
@@ -48,17 +59,114 @@ class Option{
 
         /**
         * @brief Méthode virtuelle pure pour la condition à la limite basse
+        * @param L Prix au bord bas (0 pour Crank-Nicolson, borne tronquée s_low > 0 en log-prix)
+        * @param t Temps
+        * @return Valeur de la condition à la limite basse S=L
+        */
+        virtual double boundary_condition_low(double L, double t) const = 0;
+
+        /**
+        * @brief Condition à la limite basse actualisée avec la courbe de taux de l'EDP
+        *
+        * Par défaut, renvoie boundary_condition_low(L, t) sans courbe ; une option qui ne redéfinit pas
+        * cette méthode refuse une courbe de taux.
+        * @param L Prix au bord bas
         * @param t Temps
-        * @return Valeur de la condition à la limite basse S=0
+        * @param rate Courbe de taux de l'EDP, 0 pour le taux constant de l'option
+        * @return Valeur de la condition à la limite basse S=L
+        * @throw std::invalid_argument si rate est donnée et que l'option ne la prend pas en charge
         */
-        virtual double boundary_condition_low(double L, double t) const = 0; 
+        virtual double boundary_condition_low(double L, double t, const Piecewise_curve* rate) const;
 
         /**
         * @brief Méthode virtuelle pure pour la condition à la limite haute
         * @param t Temps
         * @return Valeur de la condition à la limite haute
         */
-        virtual double boundary_condition_high(double L,double t) const = 0; 
+        virtual double boundary_condition_high(double L, double t) const = 0;
+
+        /**
+        * @brief Condition à la limite haute actualisée avec la courbe de taux de l'EDP
+        * @param L Prix au bord haut
+        * @param t Temps
+        * @param rate Courbe de taux de l'EDP, 0 pour le taux constant de l'option
+        * @return Valeur de la condition à la limite haute, boundary_condition_high(L, t) par défaut sans courbe
+        * @throw std::invalid_argument si rate est donnée et que l'option ne la prend pas en charge
+        */
+        virtual double boundary_condition_high(double L, double t, const Piecewise_curve* rate) const;
+
+        /**
+        * @brief Dérivée de la condition à la limite basse par rapport au taux r (méthode adjointe)
+        * @param L Prix au bord
+        * @param t Temps
+        * @return d(boundary_condition_low)/dr, 0 par défaut
+        */
+        virtual double boundary_condition_low_dr(double L, double t) const;
+
+        /**
+        * @brief Dérivée de la condition à la limite basse par rapport à un décalage parallèle de la courbe de taux
+        * @param L Prix au bord
+        * @param t Temps
+        * @param rate Courbe de taux de l'EDP, 0 pour le taux constant de l'option
+        * @return d(boundary_condition_low)/dr, boundary_condition_low_dr(L, t) par défaut sans courbe
+        * @throw std::invalid_argument si rate est donnée et que l'option ne la prend pas en charge
+        */
+        virtual double boundary_condition_low_dr(double L, double t, const Piecewise_curve* rate) const;
+
+        /**
+        * @brief Dérivée de la condition à la limite haute par rapport au taux r (méthode adjointe)
+        * @param L Prix au bord
+        * @param t Temps
+        * @return d(boundary_condition_high)/dr, 0 par défaut
+        */
+        virtual double boundary_condition_high_dr(double L, double t) const;
+
+        /**
+        * @brief Dérivée de la condition à la limite haute par rapport à un décalage parallèle de la courbe de taux
+        * @param L Prix au bord
+        * @param t Temps
+        * @param rate Courbe de taux de l'EDP, 0 pour le taux constant de l'option
+        * @return d(boundary_condition_high)/dr, boundary_condition_high_dr(L, t) par défaut sans courbe
+        * @throw std::invalid_argument si rate est donnée et que l'option ne la prend pas en charge
+        */
+        virtual double boundary_condition_high_dr(double L, double t, const Piecewise_curve* rate) const;
+
+        /**
+        * @brief Payoff d'une trajectoire complète (options dépendantes du chemin)
+        * @param path Prix de l'actif aux dates d'observation, de t=0 jusqu'à T
+        * @return Valeur du payoff, par défaut le payoff européen au dernier point
+        */
+        virtual double payoff_path(const std::vector<double>& path) const;
+
+        /**
+        * @brief Indique si le payoff dépend de toute la trajectoire
+        * @return false par défaut (option européenne)
+        */
+        virtual bool is_path_dependent() const;
+
+        /**
+        * @brief Points où le payoff n'est pas régulier (coude ou discontinuité)
+        * @return Liste des points singuliers, par défaut le strike
+        */
+        virtual std::vector<double> singular_points() const;
+
+        /**
+        * @brief Barrière haute désactivante (le domaine de calcul s'arrête à la barrière)
+        * @return Niveau de la barrière, +infini par défaut
+        */
+        virtual double upper_barrier() const;
+
+        /**
+        * @brief Getter pour le strike
+        * @return Strike de l'option
+        */
+        double getK() const;
+
+        /**
+        * @brief Getter pour le temps terminal
+        * @return Temps terminal
+        */
+        double getT() const;
 };
 
 
@@ -85,18 +193,51 @@ class Call : public Option{ // Classe dérivée de Option
          */
         double payoff(double S) const ;
 
+        /**
+         * @brief Méthode pour la condition à la limite basse au taux constant de l'option
+         * @param t Temps
+         * @return Valeur de la condition à la limite basse S=0
+         */
+        double boundary_condition_low(double L, double t) const ;
+
         /**
          * @brief Méthode pour la condition à la limite basse
          * @param t Temps
+         * @param rate Courbe de taux de l'EDP, 0 pour le taux constant de l'option
          * @return Valeur de la condition à la limite basse S=0
          */
-        double boundary_condition_low(double L, double t) const ;    
+        double boundary_condition_low(double L, double t, const Piecewise_curve* rate) const ;
+        /**
+         * @brief Méthode pour la condition à la limite haute au taux constant de l'option
+         * @param t Temps
+         * @return Valeur de la condition à la limite haute S=L
+         */
+        double boundary_condition_high(double L, double t) const ;
+
         /**
          * @brief Méthode pour la condition à la limite haute
          * @param t Temps
+         * @param rate Courbe de taux de l'EDP, 0 pour le taux constant de l'option
          * @return Valeur de la condition à la limite haute S=L
          */
-        double boundary_condition_high(double L, double t) const ;  
+        double boundary_condition_high(double L, double t, const Piecewise_curve* rate) const ;
+
+        /**
+         * @brief Dérivée de la condition à la limite haute par rapport à r au taux constant de l'option
+         * @param L Prix au bord
+         * @param t Temps
+         * @return d(boundary_condition_high)/dr
+         */
+        double boundary_condition_high_dr(double L, double t) const ;
+
+        /**
+         * @brief Dérivée de la condition à la limite haute par rapport à r
+         * @param L Prix au bord
+         * @param t Temps
+         * @param rate Courbe de taux de l'EDP, 0 pour le taux constant de l'option
+         * @return d(boundary_condition_high)/dr
+         */
+        double boundary_condition_high_dr(double L, double t, const Piecewise_curve* rate) const ;
 };
 
 
@@ -122,18 +263,277 @@ class Put : public Option{
          */
         double payoff(double S) const ; 
 
+        /**
+         * @brief Méthode pour la condition à la limite basse (valeur asymptotique K e^{-r(T-t)} - S) au taux constant de l'option
+         * @param L Prix au bord bas
+         * @param t Temps
+         * @return Valeur de la condition à la limite basse S=L
+         */
+        double boundary_condition_low(double L, double t) const ;
+
+        /**
+         * @brief Méthode pour la condition à la limite basse (valeur asymptotique K e^{-r(T-t)} - S)
+         * @param L Prix au bord bas
+         * @param t Temps
+         * @param rate Courbe de taux de l'EDP, 0 pour le taux constant de l'option
+         * @return Valeur de la condition à la limite basse S=L
+         */
+        double boundary_condition_low(double L, double t, const Piecewise_curve* rate) const ;
+
+        /**
+         * @brief Méthode pour la condition à la limite haute au taux constant de l'option
+         * @param t Temps
+         * @return Valeur de la condition à la limite haute S=L
+         */
+        double boundary_condition_high(double L, double t) const ;
+
+        /**
+         * @brief Méthode pour la condition à la limite haute
+         * @param t Temps
+         * @param rate Courbe de taux de l'EDP, 0 pour le taux constant de l'option
+         * @return Valeur de la condition à la limite haute S=L
+         */
+        double boundary_condition_high(double L, double t, const Piecewise_curve* rate) const ;
+
+        /**
+         * @brief Dérivée de la condition à la limite basse par rapport à r au taux constant de l'option
+         * @param L Prix au bord
+         * @param t Temps
+         * @return d(boundary_condition_low)/dr
+         */
+        double boundary_condition_low_dr(double L, double t) const ;
+
+        /**
+         * @brief Dérivée de la condition à la limite basse par rapport à r
+         * @param L Prix au bord
+         * @param t Temps
+         * @param rate Courbe de taux de l'EDP, 0 pour le taux constant de l'option
+         * @return d(boundary_condition_low)/dr
+         */
+        double boundary_condition_low_dr(double L, double t, const Piecewise_curve* rate) const ;
+};
+
+
+
+/**
+ * @brief Classe Digital_call (cash-or-nothing : paie 1 si S > K) qui hérite de la classe Option
+ */
+class Digital_call : public Option{
+    public:
+        /**
+         * @brief Constructeur de la classe Digital_call
+         * @param K Strike de l'option
+         * @param L Valeur maximale de l'actif sous-jacent
+         * @param r Taux d'intérêt sans risque
+         * @param T Temps terminal
+         */
+        Digital_call(double K, double L, double r, double T);
+
+        /**
+         * @brief Méthode pour le payoff de l'option digitale
+         * @param S Prix de l'actif sous-jacent
+         * @return 1 si S > K, 0 sinon
+         */
+        double payoff(double S) const ;
+
+        /**
+         * @brief Méthode pour la condition à la limite basse au taux constant de l'option
+         * @param t Temps
+         * @return Valeur de la condition à la limite basse S=0
+         */
+        double boundary_condition_low(double L, double t) const ;
+
         /**
          * @brief Méthode pour la condition à la limite basse
          * @param t Temps
+         * @param rate Courbe de taux de l'EDP, 0 pour le taux constant de l'option
          * @return Valeur de la condition à la limite basse S=0
          */
-        double boundary_condition_low(double L, double t) const ;     
+        double boundary_condition_low(double L, double t, const Piecewise_curve* rate) const ;
+
+        /**
+         * @brief Méthode pour la condition à la limite haute au taux constant de l'option
+         * @param t Temps
+         * @return Valeur de la condition à la limite haute S=L
+         */
+        double boundary_condition_high(double L, double t) const ;
 
         /**
          * @brief Méthode pour la condition à la limite haute
          * @param t Temps
+         * @param rate Courbe de taux de l'EDP, 0 pour le taux constant de l'option
          * @return Valeur de la condition à la limite haute S=L
          */
-        double boundary_condition_high(double L, double t) const ;    
+        double boundary_condition_high(double L, double t, const Piecewise_curve* rate) const ;
+
+        /**
+         * @brief Dérivée de la condition à la limite haute par rapport à r au taux constant de l'option
+         * @param L Prix au bord
+         * @param t Temps
+         * @return d(boundary_condition_high)/dr
+         */
+        double boundary_condition_high_dr(double L, double t) const ;
+
+        /**
+         * @brief Dérivée de la condition à la limite haute par rapport à r
+         * @param L Prix au bord
+         * @param t Temps
+         * @param rate Courbe de taux de l'EDP, 0 pour le taux constant de l'option
+         * @return d(boundary_condition_high)/dr
+         */
+        double boundary_condition_high_dr(double L, double t, const Piecewise_curve* rate) const ;
+};
+
+
+
+/**
+ * @brief Classe Digital_put (cash-or-nothing : paie 1 si S < K) qui hérite de la classe Option
+ */
+class Digital_put : public Option{
+    public:
+        /**
+         * @brief Constructeur de la classe Digital_put
+         * @param K Strike de l'option
+         * @param L Valeur maximale de l'actif sous-jacent
+         * @param r Taux d'intérêt sans risque
+         * @param T Temps terminal
+         */
+        Digital_put(double K, double L, double r, double T);
+
+        /**
+         * @brief Méthode pour le payoff de l'option digitale
+         * @param S Prix de l'actif sous-jacent
+         * @return 1 si S < K, 0 sinon
+         */
+        double payoff(double S) const ;
+
+        /**
+         * @brief Méthode pour la condition à la limite basse au taux constant de l'option
+         * @param t Temps
+         * @return Valeur de la condition à la limite basse S=0
+         */
+        double boundary_condition_low(double L, double t) const ;
+
+        /**
+         * @brief Méthode pour la condition à la limite basse
+         * @param t Temps
+         * @param rate Courbe de taux de l'EDP, 0 pour le taux constant de l'option
+         * @return Valeur de la condition à la limite basse S=0
+         */
+        double boundary_condition_low(double L, double t, const Piecewise_curve* rate) const ;
+
+        /**
+         * @brief Méthode pour la condition à la limite haute au taux constant de l'option
+         * @param t Temps
+         * @return Valeur de la condition à la limite haute S=L
+         */
+        double boundary_condition_high(double L, double t) const ;
+
+        /**
+         * @brief Méthode pour la condition à la limite haute
+         * @param t Temps
+         * @param rate Courbe de taux de l'EDP, 0 pour le taux constant de l'option
+         * @return Valeur de la condition à la limite haute S=L
+         */
+        double boundary_condition_high(double L, double t, const Piecewise_curve* rate) const ;
+
+        /**
+         * @brief Dérivée de la condition à la limite basse par rapport à r au taux constant de l'option
+         * @param L Prix au bord
+         * @param t Temps
+         * @return d(boundary_condition_low)/dr
+         */
+        double boundary_condition_low_dr(double L, double t) const ;
+
+        /**
+         * @brief Dérivée de la condition à la limite basse par rapport à r
+         * @param L Prix au bord
+         * @param t Temps
+         * @param rate Courbe de taux de l'EDP, 0 pour le taux constant de l'option
+         * @return d(boundary_condition_low)/dr
+         */
+        double boundary_condition_low_dr(double L, double t, const Piecewise_curve* rate) const ;
+};
+
+
+
+/**
+ * @brief Classe Barrier_up_out_call (call désactivant si S atteint la barrière B) qui hérite de la classe Option
+ */
+class Barrier_up_out_call : public Option{
+    protected:
+        double B_; //niveau de la barrière
+    public:
+        /**
+         * @brief Constructeur de la classe Barrier_up_out_call
+         * @param K Strike de l'option
+         * @param B Barrière haute désactivante
+         * @param L Valeur maximale de l'actif sous-jacent
+         * @param r Taux d'intérêt sans risque
+         * @param T Temps terminal
+         */
+        Barrier_up_out_call(double K, double B, double L, double r, double T);
+
+        /**
+         * @brief Méthode pour le payoff à maturité (nul au-delà de la barrière)
+         * @param S Prix de l'actif sous-jacent
+         * @return Valeur du payoff
+         */
+        double payoff(double S) const ;
+
+        /**
+         * @brief Payoff d'une trajectoire : nul si la barrière a été touchée
+         * @param path Prix de l'actif aux dates d'observation
+         * @return Valeur du payoff
+         */
+        double payoff_path(const std::vector<double>& path) const ;
+
+        /**
+         * @brief L'option désactivante dépend de la trajectoire
+         * @return true
+         */
+        bool is_path_dependent() const ;
+
+        /**
+         * @brief Points singuliers : strike et barrière
+         * @return {K, B}
+         */
+        std::vector<double> singular_points() const ;
+
+        /**
+         * @brief Barrière haute désactivante
+         * @return B
+         */
+        double upper_barrier() const ;
+
+        /**
+         * @brief Méthode pour la condition à la limite basse au taux constant de l'option
+         * @param t Temps
+         * @return Valeur de la condition à la limite basse S=0
+         */
+        double boundary_condition_low(double L, double t) const ;
+
+        /**
+         * @brief Méthode pour la condition à la limite basse
+         * @param t Temps
+         * @param rate Courbe de taux de l'EDP, 0 pour le taux constant de l'option
+         * @return Valeur de la condition à la limite basse S=0
+         */
+        double boundary_condition_low(double L, double t, const Piecewise_curve* rate) const ;
+
+        /**
+         * @brief Méthode pour la condition à la limite haute (sur la barrière) au taux constant de l'option
+         * @param t Temps
+         * @return Valeur de la condition à la limite haute S=B
+         */
+        double boundary_condition_high(double L, double t) const ;
+
+        /**
+         * @brief Méthode pour la condition à la limite haute (sur la barrière)
+         * @param t Temps
+         * @param rate Courbe de taux de l'EDP, 0 pour le taux constant de l'option
+         * @return Valeur de la condition à la limite haute S=B
+         */
+        double boundary_condition_high(double L, double t, const Piecewise_curve* rate) const ;
 };
 #endif // PAYOFF_HPP
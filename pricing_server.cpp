@@ -0,0 +1,90 @@
+/**
+ * @file pricing_server.cpp
+ * @author Mathias LE BOUEDEC - Lilou MALFOY
+ * @date 2025
+ * @brief Serveur de cotation en ligne de commande (protocole texte sur stdin/stdout)
+ *
+ * Compilation : g++ -O2 -pthread pricing_server.cpp pricing_service.cpp solver.cpp simd_math.cpp domain.cpp time_stepping.cpp
+ *               workspace.cpp edp.cpp payoff.cpp term_structure.cpp analytic.cpp -o pricing_server
+ *
+ * Commandes (une par ligne) :
+ *   add call|put K sigma r T   -> ok <id>
+ *   q <id> S                   -> <prix> <delta> <version>   (hors domaine : suffixe "bord")
+ *   m <id> sigma r T           -> ok (re-résolution en arrière-plan) ou inchangé
+ *   sync                       -> ok quand toutes les re-résolutions sont publiées
+ *   err <id>                   -> ok, ou le message de la dernière re-résolution échouée
+ *   stats                      -> n=<requêtes> p50=<ns> p99=<ns>
+ *   bench <id> S n             -> n requêtes autour de S, puis stats
+ *   quit
+ */
+
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <stdexcept>
+#include "pricing_service.hpp"
+
+int main() {
+    std::ios::sync_with_stdio(false);
+    Pricing_service service;
+    std::string line;
+
+    while (std::getline(std::cin, line)) {
+        std::istringstream in(line);
+        std::string cmd;
+        if (!(in >> cmd)) continue;
+        try {
+            if (cmd == "add") {
+                std::string type;
+                Market market;
+                in >> type >> market.K >> market.sigma >> market.r >> market.T;
+                if (!in || (type != "call" && type != "put")) throw std::invalid_argument("usage : add call|put K sigma r T");
+                market.is_call = (type == "call");
+                int id = service.add_option(market);
+                std::cout << "ok " << id << "\n";
+            } else if (cmd == "q") {
+                int id;
+                double spot;
+                in >> id >> spot;
+                if (!in) throw std::invalid_argument("usage : q <id> S");
+                Quote q = service.quote(id, spot);
+                std::cout << q.price << " " << q.delta << " " << q.version << (q.in_domain ? "" : " bord") << "\n";
+            } else if (cmd == "m") {
+                int id;
+                double sigma, r, T;
+                in >> id >> sigma >> r >> T;
+                if (!in) throw std::invalid_argument("usage : m <id> sigma r T");
+                std::cout << (service.update_market(id, sigma, r, T) ? "ok" : "inchangé") << "\n";
+            } else if (cmd == "err") {
+                int id;
+                in >> id;
+                if (!in) throw std::invalid_argument("usage : err <id>");
+                std::string error = service.last_error(id);
+                std::cout << (error.empty() ? "ok" : "erreur : " + error) << "\n";
+            } else if (cmd == "sync") {
+                service.wait_idle();
+                std::cout << "ok\n";
+            } else if (cmd == "stats" || cmd == "bench") {
+                if (cmd == "bench") {
+                    int id, n;
+                    double spot;
+                    in >> id >> spot >> n;
+                    if (!in) throw std::invalid_argument("usage : bench <id> S n");
+                    double sum = 0.0;
+                    for (int k = 0; k < n; ++k) sum += service.quote(id, spot * (1.0 + 1e-4 * (k % 200 - 100))).price;
+                    if (sum != sum) std::cout << "nan\n";
+                }
+                Latency_histogram& h = service.latency();
+                std::cout << "n=" << h.count() << " p50=" << h.percentile(0.5) << "ns p99=" << h.percentile(0.99) << "ns\n";
+            } else if (cmd == "quit") {
+                break;
+            } else {
+                std::cout << "erreur : commande inconnue " << cmd << "\n";
+            }
+        } catch (const std::exception& e) {
+            std::cout << "erreur : " << e.what() << "\n";
+        }
+        std::cout.flush();
+    }
+    return 0;
+}
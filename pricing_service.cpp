@@ -0,0 +1,316 @@
+/**
+ * @file pricing_service.cpp
+ * @author Mathias LE BOUEDEC - Lilou MALFOY
+ * @date 2025
+ * @brief Implémentation du service de cotation
+ */
+
+#include "pricing_service.hpp"
+#include "payoff.hpp"
+#include "edp.hpp"
+#include "solver.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <limits>
+#include <stdexcept>
+
+
+namespace {
+
+/**
+ * @brief Vérifie les paramètres d'une option avant de les confier au thread de fond
+ * @param market Paramètres de l'option
+ * @throw std::invalid_argument si K, sigma ou T ne sont pas strictement positifs et finis ou si r n'est pas fini
+ */
+void check_market(const Market& market) {
+    const double max = std::numeric_limits<double>::max();
+    if (!(market.K > 0.0 && market.K <= max) || !(market.sigma > 0.0 && market.sigma <= max)
+        || !(market.T > 0.0 && market.T <= max) || !(std::abs(market.r) <= max)) {
+        throw std::invalid_argument("Pricing_service : K, sigma et T doivent être strictement positifs, r fini");
+    }
+}
+
+} // namespace
+
+
+/**
+ * @brief Constructeur (compteurs à zéro)
+ */
+Latency_histogram::Latency_histogram() {
+    reset();
+}
+
+/**
+ * @brief Ajoute une mesure
+ * @param ns Latence en nanosecondes
+ */
+void Latency_histogram::record(double ns) {
+    int b = (ns > 1.0) ? static_cast<int>(4.0 * std::log2(ns)) : 0;
+    b = std::min(std::max(b, 0), n_buckets - 1);
+    counts_[b].fetch_add(1, std::memory_order_relaxed);
+}
+
+/**
+ * @brief Quantile des latences enregistrées (borne haute de la classe)
+ * @param q Niveau du quantile dans [0, 1] (0.5 : médiane, 0.99 : p99)
+ * @return Latence en nanosecondes (0 si aucune mesure)
+ */
+double Latency_histogram::percentile(double q) const {
+    unsigned long long total = count();
+    if (total == 0) return 0.0;
+    unsigned long long target = static_cast<unsigned long long>(std::ceil(q * total));
+    target = std::max(target, 1ULL);
+    unsigned long long seen = 0;
+    for (int b = 0; b < n_buckets; ++b) {
+        seen += counts_[b].load(std::memory_order_relaxed);
+        if (seen >= target) return std::exp2((b + 1) / 4.0);
+    }
+    return std::exp2(n_buckets / 4.0);
+}
+
+/**
+ * @brief Nombre de mesures enregistrées
+ * @return Nombre total de mesures
+ */
+unsigned long long Latency_histogram::count() const {
+    unsigned long long total = 0;
+    for (int b = 0; b < n_buckets; ++b) total += counts_[b].load(std::memory_order_relaxed);
+    return total;
+}
+
+/**
+ * @brief Remet les compteurs à zéro
+ */
+void Latency_histogram::reset() {
+    for (int b = 0; b < n_buckets; ++b) counts_[b].store(0, std::memory_order_relaxed);
+}
+
+
+/**
+ * @brief Constructeur, démarre le thread de fond
+ * @param N Nombre de points en espace des résolutions
+ * @param M Nombre de pas de temps des résolutions
+ * @param max_options Nombre maximal d'options enregistrées
+ */
+Pricing_service::Pricing_service(int N, int M, int max_options)
+    : N_(N), M_(M), slots_(std::max(max_options, 1)), n_slots_(0), busy_(0), stop_(false) {
+    worker_ = std::thread(&Pricing_service::run, this);
+}
+
+/**
+ * @brief Destructeur, arrête le thread de fond
+ */
+Pricing_service::~Pricing_service() {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stop_ = true;
+    }
+    wake_.notify_all();
+    worker_.join();
+}
+
+/**
+ * @brief Résout l'EDP et construit la surface à t=0
+ * @param market Paramètres de l'option
+ * @param version Numéro de version de la surface
+ * @return Surface prête à publier
+ */
+std::shared_ptr<const Price_surface> Pricing_service::build_surface(const Market& market, unsigned long version) const {
+    std::shared_ptr<Price_surface> surface(new Price_surface());
+    surface->market = market;
+    surface->version = version;
+
+    //le L de l'EDP est remplacé par le domaine automatique autour du strike
+    Call call(market.K, 2.0 * market.K, market.r, market.T);
+    Put put(market.K, 2.0 * market.K, market.r, market.T);
+    Option* option = market.is_call ? static_cast<Option*>(&call) : static_cast<Option*>(&put);
+    EDP edp(option, market.sigma, market.r, market.T, 2.0 * market.K);
+
+    Cranck_nicolson solver(edp, N_, M_);
+    solver.set_auto_domain(std::vector<double>(1, market.K));
+    solver.set_grid_alignment(ALIGN_NODE);
+    solver.set_payoff_smoothing(true);
+    solver.set_time_scheme(SCHEME_TR_BDF2);
+    solver.solve();
+
+    std::vector<double> grid = solver.get_grid();
+    surface->price = solver.get_surface()[0]; //seule la ligne t=0 est copiée
+    surface->s_low = grid[0];
+    surface->dS = grid[1] - grid[0];
+
+    //delta aux noeuds : différences centrées, décentrées aux bords
+    const std::vector<double>& v = surface->price;
+    std::vector<double>& delta = surface->delta;
+    delta.resize(v.size());
+    std::size_t n = v.size() - 1;
+    for (std::size_t i = 1; i < n; ++i) delta[i] = (v[i + 1] - v[i - 1]) / (2.0 * surface->dS);
+    delta[0] = (v[1] - v[0]) / surface->dS;
+    delta[n] = (v[n] - v[n - 1]) / surface->dS;
+    return surface;
+}
+
+/**
+ * @brief Enregistre une option et la résout immédiatement
+ * @param market Paramètres de l'option
+ * @return Identifiant de l'option
+ * @throw std::invalid_argument si K, sigma ou T ne sont pas strictement positifs ou si r n'est pas fini
+ * @throw std::length_error si la capacité est atteinte
+ */
+int Pricing_service::add_option(const Market& market) {
+    check_market(market);
+    std::lock_guard<std::mutex> add_lock(add_mutex_);
+    std::unique_lock<std::mutex> lock(mutex_);
+    int id = n_slots_.load();
+    if (id >= static_cast<int>(slots_.size())) {
+        throw std::length_error("Pricing_service : nombre maximal d'options atteint");
+    }
+    Slot& slot = slots_[id];
+    slot.pending = market;
+    slot.dirty = false;
+    slot.version = 1;
+    slot.error.clear();
+    lock.unlock();
+
+    std::atomic_store(&slot.surface, build_surface(market, 1));
+    n_slots_.store(id + 1); //l'option n'est visible qu'une fois sa première surface publiée
+    return id;
+}
+
+/**
+ * @brief Demande de nouveaux paramètres de marché ; la re-résolution se fait en arrière-plan
+ * @param id Identifiant de l'option
+ * @param sigma Volatilité
+ * @param r Taux sans risque
+ * @param T Maturité
+ * @return true si une re-résolution a été programmée
+ * @throw std::out_of_range si l'identifiant est inconnu
+ * @throw std::invalid_argument si sigma ou T ne sont pas strictement positifs ou si r n'est pas fini
+ */
+bool Pricing_service::update_market(int id, double sigma, double r, double T) {
+    if (id < 0 || id >= n_slots_.load()) {
+        throw std::out_of_range("Pricing_service : option inconnue");
+    }
+    std::lock_guard<std::mutex> lock(mutex_);
+    Slot& slot = slots_[id];
+    Market market = slot.pending;
+    market.sigma = sigma;
+    market.r = r;
+    market.T = T;
+    check_market(market); //refusé ici, dans le thread de l'appelant, plutôt qu'au moment de la résolution
+    if (slot.pending.sigma == sigma && slot.pending.r == r && slot.pending.T == T) return false;
+    slot.pending.sigma = sigma;
+    slot.pending.r = r;
+    slot.pending.T = T;
+    if (!slot.dirty) {
+        slot.dirty = true;
+        queue_.push_back(id);
+        wake_.notify_one();
+    }
+    return true;
+}
+
+/**
+ * @brief Boucle du thread de fond
+ */
+void Pricing_service::run() {
+    std::unique_lock<std::mutex> lock(mutex_);
+    while (true) {
+        wake_.wait(lock, [this]() { return stop_ || !queue_.empty(); });
+        if (stop_) return;
+
+        //les paramètres sont lus au moment de la résolution : les mises à jour intermédiaires sont fusionnées
+        int id = queue_.front();
+        queue_.erase(queue_.begin());
+        Slot& slot = slots_[id];
+        Market market = slot.pending;
+        slot.dirty = false;
+        unsigned long version = slot.version + 1;
+        busy_++;
+        lock.unlock();
+
+        //un échec garde la surface précédente publiée : le thread de fond ne doit pas laisser passer d'exception
+        std::string error;
+        try {
+            std::shared_ptr<const Price_surface> surface = build_surface(market, version);
+            std::atomic_store(&slot.surface, surface);
+        } catch (const std::exception& e) {
+            error = e.what();
+        } catch (...) {
+            error = "Pricing_service : échec de la re-résolution";
+        }
+
+        lock.lock();
+        if (error.empty()) slot.version = version;
+        slot.error = error;
+        busy_--;
+        if (busy_ == 0 && queue_.empty()) idle_.notify_all();
+    }
+}
+
+/**
+ * @brief Erreur de la dernière re-résolution en arrière-plan de l'option
+ * @param id Identifiant de l'option
+ * @return Message de l'échec, vide si la dernière re-résolution a été publiée
+ * @throw std::out_of_range si l'identifiant est inconnu
+ */
+std::string Pricing_service::last_error(int id) {
+    if (id < 0 || id >= n_slots_.load()) {
+        throw std::out_of_range("Pricing_service : option inconnue");
+    }
+    std::lock_guard<std::mutex> lock(mutex_);
+    return slots_[id].error;
+}
+
+/**
+ * @brief Prix et delta au spot demandé par interpolation sur la surface courante (sans le mutex du service)
+ * @param id Identifiant de l'option
+ * @param spot Prix de l'actif
+ * @return Cotation
+ * @throw std::out_of_range si l'identifiant est inconnu
+ * @throw std::invalid_argument si le spot n'est pas fini
+ */
+Quote Pricing_service::quote(int id, double spot) {
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    if (id < 0 || id >= n_slots_.load(std::memory_order_acquire)) {
+        throw std::out_of_range("Pricing_service : option inconnue");
+    }
+    if (!std::isfinite(spot)) {
+        //NaN traverserait le min/max et static_cast<int> lirait hors de la surface
+        throw std::invalid_argument("Pricing_service : le spot doit être fini");
+    }
+    std::shared_ptr<const Price_surface> surface = std::atomic_load(&slots_[id].surface);
+
+    //grille uniforme : l'intervalle se calcule directement
+    const std::vector<double>& v = surface->price;
+    const std::vector<double>& d = surface->delta;
+    int n = static_cast<int>(v.size()) - 1;
+    double x = (spot - surface->s_low) / surface->dS;
+    Quote q;
+    q.version = surface->version;
+    q.in_domain = (x >= 0.0 && x <= n);
+    x = std::min(std::max(x, 0.0), static_cast<double>(n));
+    int i = std::min(static_cast<int>(x), n - 1);
+    double w = x - i;
+    q.price = (1.0 - w) * v[i] + w * v[i + 1];
+    q.delta = (1.0 - w) * d[i] + w * d[i + 1];
+
+    latency_.record(std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count());
+    return q;
+}
+
+/**
+ * @brief Attend que toutes les re-résolutions demandées soient publiées
+ */
+void Pricing_service::wait_idle() {
+    std::unique_lock<std::mutex> lock(mutex_);
+    idle_.wait(lock, [this]() { return busy_ == 0 && queue_.empty(); });
+}
+
+/**
+ * @brief Getter pour l'histogramme des latences de quote()
+ * @return Référence vers l'histogramme
+ */
+Latency_histogram& Pricing_service::latency() {
+    return latency_;
+}
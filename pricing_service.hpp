@@ -0,0 +1,217 @@
+/**
+ * @file pricing_service.hpp
+ * @author Mathias LE BOUEDEC - Lilou MALFOY
+ * @date 2025
+ * @brief Service de cotation : surfaces résolues gardées en mémoire, requêtes par interpolation, re-résolution en arrière-plan
+ */
+
+#ifndef PRICING_SERVICE_HPP
+#define PRICING_SERVICE_HPP
+
+#include <atomic>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+
+/**
+ * @brief Paramètres d'une option cotée par le service
+ */
+struct Market {
+    bool is_call;  // call ou put européen
+    double K;      // strike
+    double sigma;  // volatilité
+    double r;      // taux sans risque
+    double T;      // maturité
+};
+
+
+/**
+ * @brief Prix et delta à t=0 sur une grille uniforme en S, immuable une fois publiée
+ */
+struct Price_surface {
+    Market market;              // paramètres ayant servi à la résolution
+    double s_low;               // premier noeud
+    double dS;                  // pas de la grille
+    std::vector<double> price;  // prix aux noeuds
+    std::vector<double> delta;  // delta aux noeuds (différences centrées)
+    unsigned long version;      // numéro de publication de l'option
+};
+
+
+/**
+ * @brief Réponse à une requête de cotation
+ */
+struct Quote {
+    double price;           // prix interpolé
+    double delta;           // delta interpolé
+    bool in_domain;         // false si le spot est hors de la grille (valeur du bord)
+    unsigned long version;  // version de la surface utilisée
+};
+
+
+/**
+ * @brief Histogramme de latences à classes logarithmiques (4 classes par octave), sans verrou
+ */
+class Latency_histogram {
+private:
+    static const int n_buckets = 160;          // jusqu'à 2^40 ns
+    std::atomic<unsigned long long> counts_[n_buckets];
+
+public:
+    /**
+     * @brief Constructeur (compteurs à zéro)
+     */
+    Latency_histogram();
+
+    /**
+     * @brief Ajoute une mesure
+     * @param ns Latence en nanosecondes
+     */
+    void record(double ns);
+
+    /**
+     * @brief Quantile des latences enregistrées (borne haute de la classe)
+     * @param q Niveau du quantile dans [0, 1] (0.5 : médiane, 0.99 : p99)
+     * @return Latence en nanosecondes (0 si aucune mesure)
+     */
+    double percentile(double q) const;
+
+    /**
+     * @brief Nombre de mesures enregistrées
+     * @return Nombre total de mesures
+     */
+    unsigned long long count() const;
+
+    /**
+     * @brief Remet les compteurs à zéro
+     */
+    void reset();
+};
+
+
+/**
+ * @brief Service de cotation en continu
+ *
+ * Chaque option enregistrée garde sa dernière surface résolue ; les requêtes ne prennent pas le mutex du service
+ * et lisent la surface courante par un shared_ptr chargé atomiquement. Un changement de sigma, r ou T
+ * déclenche une re-résolution par le thread de fond, puis la nouvelle surface remplace l'ancienne
+ * d'un seul coup (les requêtes en cours finissent sur l'ancienne).
+ */
+class Pricing_service {
+private:
+    /**
+     * @brief Option enregistrée
+     */
+    struct Slot {
+        std::shared_ptr<const Price_surface> surface; // surface publiée (accès atomique)
+        Market pending;                              // derniers paramètres demandés
+        bool dirty;                                  // re-résolution en attente
+        unsigned long version;                       // dernière version publiée
+        std::string error;                           // message de la dernière re-résolution échouée (vide sinon)
+    };
+
+    int N_, M_;                  // grille des résolutions
+    std::vector<Slot> slots_;    // options (capacité fixée à la construction)
+    std::atomic<int> n_slots_;   // options enregistrées
+    Latency_histogram latency_;  // latences des requêtes
+
+    std::mutex add_mutex_;            // sérialise add_option
+    std::mutex mutex_;                // protège pending, dirty et la file
+    std::condition_variable wake_;    // réveille le thread de fond
+    std::condition_variable idle_;    // signale la fin des re-résolutions
+    std::vector<int> queue_;          // options à re-résoudre
+    int busy_;                        // re-résolutions en cours
+    bool stop_;                       // arrêt du thread de fond
+    std::thread worker_;              // thread de re-résolution
+
+    /**
+     * @brief Résout l'EDP et construit la surface à t=0
+     * @param market Paramètres de l'option
+     * @param version Numéro de version de la surface
+     * @return Surface prête à publier
+     */
+    std::shared_ptr<const Price_surface> build_surface(const Market& market, unsigned long version) const;
+
+    /**
+     * @brief Boucle du thread de fond
+     */
+    void run();
+
+    Pricing_service(const Pricing_service&);
+    Pricing_service& operator=(const Pricing_service&);
+
+public:
+    /**
+     * @brief Constructeur, démarre le thread de fond
+     * @param N Nombre de points en espace des résolutions
+     * @param M Nombre de pas de temps des résolutions
+     * @param max_options Nombre maximal d'options enregistrées
+     */
+    Pricing_service(int N = 800, int M = 200, int max_options = 256);
+
+    /**
+     * @brief Destructeur, arrête le thread de fond
+     */
+    ~Pricing_service();
+
+    /**
+     * @brief Enregistre une option et la résout immédiatement
+     * @param market Paramètres de l'option
+     * @return Identifiant de l'option
+     * @throw std::invalid_argument si K, sigma ou T ne sont pas strictement positifs ou si r n'est pas fini
+     * @throw std::length_error si la capacité est atteinte
+     */
+    int add_option(const Market& market);
+
+    /**
+     * @brief Demande de nouveaux paramètres de marché ; la re-résolution se fait en arrière-plan
+     *
+     * Rien n'est recalculé si sigma, r et T sont inchangés ; plusieurs mises à jour rapprochées
+     * ne donnent qu'une résolution avec les derniers paramètres. Si la re-résolution échoue malgré tout,
+     * la surface précédente reste publiée et last_error() donne le message.
+     * @param id Identifiant de l'option
+     * @param sigma Volatilité
+     * @param r Taux sans risque
+     * @param T Maturité
+     * @return true si une re-résolution a été programmée
+     * @throw std::out_of_range si l'identifiant est inconnu
+     * @throw std::invalid_argument si sigma ou T ne sont pas strictement positifs ou si r n'est pas fini
+     */
+    bool update_market(int id, double sigma, double r, double T);
+
+    /**
+     * @brief Erreur de la dernière re-résolution en arrière-plan de l'option
+     * @param id Identifiant de l'option
+     * @return Message de l'échec, vide si la dernière re-résolution a été publiée
+     * @throw std::out_of_range si l'identifiant est inconnu
+     */
+    std::string last_error(int id);
+
+    /**
+     * @brief Prix et delta au spot demandé par interpolation sur la surface courante (sans le mutex du service)
+     * @param id Identifiant de l'option
+     * @param spot Prix de l'actif
+     * @return Cotation
+     * @throw std::out_of_range si l'identifiant est inconnu
+     * @throw std::invalid_argument si le spot n'est pas fini
+     */
+    Quote quote(int id, double spot);
+
+    /**
+     * @brief Attend que toutes les re-résolutions demandées soient publiées
+     */
+    void wait_idle();
+
+    /**
+     * @brief Getter pour l'histogramme des latences de quote()
+     * @return Référence vers l'histogramme
+     */
+    Latency_histogram& latency();
+};
+
+
+#endif // PRICING_SERVICE_HPP
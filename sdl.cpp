@@ -133,4 +133,175 @@ void Sdl::draw_curve(const std::vector<double>& x, const std::vector<double>& y,
 void Sdl::show()
 {
     SDL_RenderPresent(renderer_);
-}
\ No newline at end of file
+}
+
+/**
+ * @brief Constructeur
+ * @param renderer Renderer SDL
+ * @param width Largeur de la carte en pixels
+ * @param height Hauteur de la carte en pixels
+ */
+Heatmap::Heatmap(SDL_Renderer* renderer, int width, int height)
+    : renderer_(renderer), texture_(nullptr), width_(width), height_(height), vmin_(0.0), vmax_(1.0),
+      pixels_(static_cast<std::size_t>(width) * height, 0xFF000000u), sum_(width), count_(width)
+{
+    texture_ = SDL_CreateTexture(renderer_, SDL_PIXELFORMAT_ARGB8888, SDL_TEXTUREACCESS_STREAMING, width_, height_);
+    if (texture_ == nullptr) {
+        std::cout << "Erreur Texture : " << SDL_GetError() << std::endl;
+    }
+
+    //palette : bleu foncé, bleu, cyan, jaune, rouge
+    const int anchors[5][3] = {{0, 0, 128}, {0, 0, 255}, {0, 255, 255}, {255, 255, 0}, {255, 0, 0}};
+    for (int k = 0; k < 256; ++k) {
+        double x = k / 255.0 * 4.0;
+        int a = std::min(static_cast<int>(x), 3);
+        double w = x - a;
+        Uint32 rgb[3];
+        for (int c = 0; c < 3; ++c) {
+            rgb[c] = static_cast<Uint32>((1.0 - w) * anchors[a][c] + w * anchors[a + 1][c] + 0.5);
+        }
+        palette_[k] = 0xFF000000u | (rgb[0] << 16) | (rgb[1] << 8) | rgb[2];
+    }
+}
+
+/**
+ * @brief Destructeur (détruit la texture)
+ */
+Heatmap::~Heatmap()
+{
+    if (texture_ != nullptr) SDL_DestroyTexture(texture_);
+}
+
+/**
+ * @brief Fixe la plage de valeurs de la palette
+ * @param vmin Valeur affichée en bleu
+ * @param vmax Valeur affichée en rouge
+ */
+void Heatmap::set_range(double vmin, double vmax)
+{
+    vmin_ = vmin;
+    vmax_ = (vmax > vmin) ? vmax : vmin + 1.0;
+}
+
+/**
+ * @brief Ajuste la plage de valeurs sur les lignes [row_begin, row_end) de la surface
+ * @param v Surface
+ * @param row_begin Première ligne
+ * @param row_end Ligne suivant la dernière
+ */
+void Heatmap::fit_range(const std::vector< std::vector<double> >& v, int row_begin, int row_end)
+{
+    double lo = std::numeric_limits<double>::max();
+    double hi = -std::numeric_limits<double>::max();
+    for (int j = std::max(row_begin, 0); j < std::min(row_end, static_cast<int>(v.size())); ++j) {
+        for (std::size_t i = 0; i < v[j].size(); ++i) {
+            if (v[j][i] == v[j][i]) { //NaN exclus
+                lo = std::min(lo, v[j][i]);
+                hi = std::max(hi, v[j][i]);
+            }
+        }
+    }
+    if (lo <= hi) set_range(lo, hi);
+}
+
+/**
+ * @brief Recalcule les lignes de pixels [py_begin, py_end) depuis la surface
+ * @param v Surface (lignes en temps, colonnes en S)
+ * @param py_begin Première ligne de pixels
+ * @param py_end Ligne de pixels suivant la dernière
+ */
+void Heatmap::render_rows(const std::vector< std::vector<double> >& v, int py_begin, int py_end)
+{
+    const long rows = static_cast<long>(v.size());
+    const int cols = static_cast<int>(v[0].size());
+    const bool scatter = (cols >= width_); //plus de noeuds que de pixels : moyenne, sinon noeud le plus proche
+    if (scatter && static_cast<int>(column_.size()) != cols) {
+        column_.resize(cols);
+        for (int i = 0; i < cols; ++i) column_[i] = static_cast<int>(static_cast<long>(i) * width_ / cols);
+    }
+    const double scale = 255.0 / (vmax_ - vmin_);
+
+    for (int py = py_begin; py < py_end; ++py) {
+        long j0 = py * rows / height_;
+        long j1 = std::max(j0 + 1, (py + 1) * rows / height_);
+        std::fill(sum_.begin(), sum_.end(), 0.0);
+        std::fill(count_.begin(), count_.end(), 0);
+
+        //un seul passage sur les noeuds de la bande de lignes
+        for (long j = j0; j < j1; ++j) {
+            const std::vector<double>& row = v[j];
+            if (scatter) {
+                for (int i = 0; i < cols; ++i) {
+                    sum_[column_[i]] += row[i];
+                    count_[column_[i]]++;
+                }
+            } else {
+                for (int px = 0; px < width_; ++px) {
+                    sum_[px] += row[static_cast<long>(px) * cols / width_];
+                    count_[px]++;
+                }
+            }
+        }
+
+        Uint32* out = &pixels_[static_cast<std::size_t>(py) * width_];
+        for (int px = 0; px < width_; ++px) {
+            double value = sum_[px] / count_[px];
+            if (value != value) {
+                out[px] = 0xFF000000u; //NaN en noir
+                continue;
+            }
+            int k = static_cast<int>((value - vmin_) * scale);
+            out[px] = palette_[std::min(std::max(k, 0), 255)];
+        }
+    }
+}
+
+/**
+ * @brief Met à jour la texture pour les lignes [row_begin, row_end) de la surface
+ * @param v Surface (lignes en temps, colonnes en S)
+ * @param row_begin Première ligne modifiée
+ * @param row_end Ligne suivant la dernière ligne modifiée
+ */
+void Heatmap::update_rows(const std::vector< std::vector<double> >& v, int row_begin, int row_end)
+{
+    if (texture_ == nullptr || v.empty() || v[0].empty() || row_end <= row_begin) return;
+    const long rows = static_cast<long>(v.size());
+
+    //lignes de pixels dont la bande de lignes de la surface coupe [row_begin, row_end)
+    int py_begin = static_cast<int>(std::max(0L, row_begin * height_ / rows));
+    int py_end = static_cast<int>(std::min(static_cast<long>(height_), (row_end * height_ + rows - 1) / rows + 1));
+    render_rows(v, py_begin, py_end);
+
+    SDL_Rect rect;
+    rect.x = 0;
+    rect.y = py_begin;
+    rect.w = width_;
+    rect.h = py_end - py_begin;
+    SDL_UpdateTexture(texture_, &rect, &pixels_[static_cast<std::size_t>(py_begin) * width_], width_ * static_cast<int>(sizeof(Uint32)));
+}
+
+/**
+ * @brief Met à jour toute la texture
+ * @param v Surface (lignes en temps, colonnes en S)
+ */
+void Heatmap::update(const std::vector< std::vector<double> >& v)
+{
+    update_rows(v, 0, static_cast<int>(v.size()));
+}
+
+/**
+ * @brief Efface la texture (noir), avant une résolution suivie ligne par ligne
+ */
+void Heatmap::clear()
+{
+    std::fill(pixels_.begin(), pixels_.end(), 0xFF000000u);
+    if (texture_ != nullptr) SDL_UpdateTexture(texture_, nullptr, &pixels_[0], width_ * static_cast<int>(sizeof(Uint32)));
+}
+
+/**
+ * @brief Copie la texture dans le renderer (à afficher ensuite avec SDL_RenderPresent)
+ */
+void Heatmap::draw()
+{
+    if (texture_ != nullptr) SDL_RenderCopy(renderer_, texture_, nullptr, nullptr);
+}
@@ -77,4 +77,91 @@ class Sdl
         void show();
 };
 
+
+/**
+ * @brief Carte de chaleur d'une surface (t, S) dans une texture SDL en flux (SDL_TEXTUREACCESS_STREAMING)
+ *
+ * La surface est réduite à la résolution de l'écran en un seul passage (moyenne des noeuds de chaque pixel,
+ * ou noeud le plus proche si la surface est plus petite que l'écran) ; seules les lignes de pixels touchées
+ * par les lignes modifiées de la surface sont recalculées et envoyées par SDL_UpdateTexture.
+ * La ligne 0 de la surface (t=0) est en haut, S croît vers la droite.
+ */
+class Heatmap
+{
+    private:
+        SDL_Renderer* renderer_;     // Renderer SDL
+        SDL_Texture* texture_;       // Texture en flux à la taille de l'écran
+        int width_, height_;         // Taille de la texture en pixels
+        double vmin_, vmax_;         // Plage de valeurs associée à la palette
+        std::vector<Uint32> pixels_; // Image ARGB8888, une ligne de pixels après l'autre
+        std::vector<double> sum_;    // Somme des noeuds d'une ligne de pixels
+        std::vector<int> count_;     // Nombre de noeuds d'une ligne de pixels
+        std::vector<int> column_;    // Colonne de pixels de chaque noeud en S (surface plus large que l'écran)
+        Uint32 palette_[256];        // Palette bleu - cyan - jaune - rouge
+
+        /**
+        * @brief Recalcule les lignes de pixels [py_begin, py_end) depuis la surface
+        * @param v Surface (lignes en temps, colonnes en S)
+        * @param py_begin Première ligne de pixels
+        * @param py_end Ligne de pixels suivant la dernière
+        */
+        void render_rows(const std::vector< std::vector<double> >& v, int py_begin, int py_end);
+
+        Heatmap(const Heatmap&);
+        Heatmap& operator=(const Heatmap&);
+
+    public:
+        /**
+        * @brief Constructeur
+        * @param renderer Renderer SDL
+        * @param width Largeur de la carte en pixels
+        * @param height Hauteur de la carte en pixels
+        */
+        Heatmap(SDL_Renderer* renderer, int width, int height);
+
+        /**
+        * @brief Destructeur (détruit la texture)
+        */
+        ~Heatmap();
+
+        /**
+        * @brief Fixe la plage de valeurs de la palette
+        * @param vmin Valeur affichée en bleu
+        * @param vmax Valeur affichée en rouge
+        */
+        void set_range(double vmin, double vmax);
+
+        /**
+        * @brief Ajuste la plage de valeurs sur les lignes [row_begin, row_end) de la surface
+        * @param v Surface
+        * @param row_begin Première ligne
+        * @param row_end Ligne suivant la dernière
+        */
+        void fit_range(const std::vector< std::vector<double> >& v, int row_begin, int row_end);
+
+        /**
+        * @brief Met à jour la texture pour les lignes [row_begin, row_end) de la surface
+        * @param v Surface (lignes en temps, colonnes en S)
+        * @param row_begin Première ligne modifiée
+        * @param row_end Ligne suivant la dernière ligne modifiée
+        */
+        void update_rows(const std::vector< std::vector<double> >& v, int row_begin, int row_end);
+
+        /**
+        * @brief Met à jour toute la texture
+        * @param v Surface (lignes en temps, colonnes en S)
+        */
+        void update(const std::vector< std::vector<double> >& v);
+
+        /**
+        * @brief Efface la texture (noir), avant une résolution suivie ligne par ligne
+        */
+        void clear();
+
+        /**
+        * @brief Copie la texture dans le renderer (à afficher ensuite avec SDL_RenderPresent)
+        */
+        void draw();
+};
+
 #endif 
\ No newline at end of file
@@ -0,0 +1,306 @@
+/**
+ * @file shard_coordinator.cpp
+ * @author Mathias LE BOUEDEC - Lilou MALFOY
+ * @date 2025
+ * @brief Implémentation du coordinateur multi-processus (fork, mémoire partagée POSIX, relances)
+ */
+
+#include "shard_coordinator.hpp"
+#include "payoff.hpp"
+#include "edp.hpp"
+#include "solver.hpp"
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <chrono>
+#include <cstring>
+#include <map>
+#include <sstream>
+#include <stdexcept>
+#include <thread>
+#include <fcntl.h>
+#include <signal.h>
+#include <sys/mman.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+
+namespace {
+
+/**
+ * @brief État d'une option dans le segment partagé
+ */
+enum Job_status {
+    JOB_PENDING = 0, // pas encore résolue (ou processus perdu en cours de résolution)
+    JOB_DONE = 1,    // tranche écrite
+    JOB_FAILED = 2   // la résolution a levé une exception
+};
+
+/**
+ * @brief En-tête d'une option dans le segment partagé, écrit par le processus de calcul
+ */
+struct Job_header {
+    int status;    // Job_status, écrit en dernier
+    int pad;
+    double s_low;  // premier noeud
+    double dS;     // pas de la grille
+};
+
+/**
+ * @brief Résout une option et écrit sa tranche à t=0 dans le segment partagé
+ * @param spec Option
+ * @param header En-tête de l'option
+ * @param out Emplacement des N+1 prix
+ */
+void price_option(const Option_spec& spec, Job_header& header, double* out) {
+    try {
+        Call call(spec.K, spec.L, spec.r, spec.T);
+        Put put(spec.K, spec.L, spec.r, spec.T);
+        Option* option = spec.is_call ? static_cast<Option*>(&call) : static_cast<Option*>(&put);
+        EDP edp(option, spec.sigma, spec.r, spec.T, spec.L);
+        Cranck_nicolson solver(edp, spec.N, spec.M);
+        solver.set_time_scheme(SCHEME_RANNACHER);
+        solver.solve();
+        const std::vector<double>& row = solver.get_surface()[0];
+        std::vector<double> grid = solver.get_grid();
+        if (static_cast<int>(row.size()) != spec.N + 1) throw std::length_error("tranche de taille inattendue");
+        std::memcpy(out, &row[0], row.size() * sizeof(double));
+        header.s_low = grid[0];
+        header.dS = grid[1] - grid[0];
+        __atomic_store_n(&header.status, static_cast<int>(JOB_DONE), __ATOMIC_RELEASE);
+    } catch (const std::exception&) {
+        __atomic_store_n(&header.status, static_cast<int>(JOB_FAILED), __ATOMIC_RELEASE);
+    }
+}
+
+/**
+ * @brief Corps d'un processus de calcul : résout les options encore en attente de son lot
+ * @param portfolio Portefeuille
+ * @param jobs Indices des options du lot
+ * @param headers En-têtes du segment partagé
+ * @param data Zone des prix du segment partagé
+ * @param offset Début de chaque tranche dans data
+ * @param crash_after Nombre d'options avant interruption volontaire (-1 : aucune)
+ * @param hang true si l'interruption bloque le processus au lieu de le tuer
+ */
+void run_shard(const std::vector<Option_spec>& portfolio, const std::vector<int>& jobs, Job_header* headers,
+               double* data, const std::vector<std::size_t>& offset, int crash_after, bool hang) {
+    int solved = 0;
+    for (std::size_t k = 0; k < jobs.size(); ++k) {
+        int j = jobs[k];
+        if (headers[j].status != JOB_PENDING) continue;
+        if (solved == crash_after) {
+            while (hang) pause();
+            raise(SIGKILL);
+        }
+        price_option(portfolio[j], headers[j], data + offset[j]);
+        ++solved;
+    }
+}
+
+} // namespace
+
+
+/**
+ * @brief Répartition par coût estimé, plus gros d'abord (LPT) : chaque option va au lot le moins chargé
+ * @param cost Coût estimé de chaque option
+ * @param n_shards Nombre de lots
+ * @return Indices des options de chaque lot
+ */
+std::vector< std::vector<int> > balance_shards(const std::vector<double>& cost, int n_shards) {
+    std::vector< std::vector<int> > shards(std::max(n_shards, 1));
+    std::vector<int> order(cost.size());
+    for (std::size_t j = 0; j < order.size(); ++j) order[j] = static_cast<int>(j);
+    std::stable_sort(order.begin(), order.end(), [&cost](int a, int b) { return cost[a] > cost[b]; });
+
+    std::vector<double> load(shards.size(), 0.0);
+    for (std::size_t k = 0; k < order.size(); ++k) {
+        std::size_t s = std::min_element(load.begin(), load.end()) - load.begin();
+        shards[s].push_back(order[k]);
+        load[s] += cost[order[k]];
+    }
+    return shards;
+}
+
+
+/**
+ * @brief Constructeur
+ * @param workers Nombre de processus de calcul
+ * @param max_retries Relances maximales d'un lot dont le processus a échoué
+ * @throw std::invalid_argument si workers < 1 ou max_retries < 0
+ */
+Shard_coordinator::Shard_coordinator(int workers, int max_retries)
+    : workers_(workers), max_retries_(max_retries), crash_shard_(-1), crash_after_(0), crash_hang_(false),
+      attempt_timeout_(300.0) {
+    if (workers < 1 || max_retries < 0) throw std::invalid_argument("Shard_coordinator : workers >= 1, max_retries >= 0");
+    report_.workers = workers;
+    report_.options = report_.failed = report_.retries = report_.timeouts = report_.inline_shards = 0;
+    report_.seconds = report_.options_per_second = report_.cells_per_second = 0.0;
+}
+
+/**
+ * @brief Interrompt la première tentative d'un lot (SIGKILL ou blocage) pour vérifier les relances
+ * @param shard Indice du lot (-1 pour désactiver)
+ * @param after_options Nombre d'options résolues avant l'interruption
+ * @param hang true pour bloquer le processus (il sera tué au délai) au lieu de le tuer
+ */
+void Shard_coordinator::set_fault_injection(int shard, int after_options, bool hang) {
+    crash_shard_ = shard;
+    crash_after_ = std::max(after_options, 0);
+    crash_hang_ = hang;
+}
+
+/**
+ * @brief Délai d'une tentative : au-delà, le processus est tué et la tentative comptée en échec
+ * @param seconds Délai en secondes (300 par défaut, 0 : aucun)
+ */
+void Shard_coordinator::set_attempt_timeout(double seconds) {
+    attempt_timeout_ = std::max(seconds, 0.0);
+}
+
+/**
+ * @brief Résout le portefeuille sur les processus de calcul
+ * @param portfolio Options à résoudre
+ * @return Une tranche par option, dans l'ordre du portefeuille
+ * @throw std::runtime_error si le segment de mémoire partagée ne peut pas être créé
+ */
+std::vector<Price_slice> Shard_coordinator::run(const std::vector<Option_spec>& portfolio) {
+    const std::size_t n = portfolio.size();
+
+    //coût estimé N M, emplacement de chaque tranche dans le segment
+    std::vector<double> cost(n);
+    std::vector<std::size_t> offset(n + 1, 0);
+    for (std::size_t j = 0; j < n; ++j) {
+        const Option_spec& spec = portfolio[j];
+        cost[j] = static_cast<double>(std::max(spec.N, 1)) * std::max(spec.M, 1);
+        offset[j + 1] = offset[j] + static_cast<std::size_t>(std::max(spec.N + 1, 0));
+    }
+    std::vector< std::vector<int> > shards = balance_shards(cost, workers_);
+
+    //segment partagé : en-têtes puis prix ; le nom est retiré dès le mmap, les fils héritent de la projection
+    std::size_t bytes = std::max<std::size_t>(n * sizeof(Job_header) + offset[n] * sizeof(double), 1);
+    static std::atomic<int> counter(0); //plusieurs coordinateurs peuvent tourner en même temps sur des threads différents
+    std::ostringstream name;
+    name << "/bs_shard_" << getpid() << "_" << counter.fetch_add(1);
+    int fd = shm_open(name.str().c_str(), O_CREAT | O_EXCL | O_RDWR, 0600);
+    if (fd < 0) throw std::runtime_error("Shard_coordinator : shm_open a échoué");
+    shm_unlink(name.str().c_str());
+    if (ftruncate(fd, static_cast<off_t>(bytes)) != 0) {
+        close(fd);
+        throw std::runtime_error("Shard_coordinator : ftruncate a échoué");
+    }
+    void* base = mmap(0, bytes, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    close(fd);
+    if (base == MAP_FAILED) throw std::runtime_error("Shard_coordinator : mmap a échoué");
+    Job_header* headers = static_cast<Job_header*>(base);
+    double* data = reinterpret_cast<double*>(headers + n); // segment neuf : tous les états à JOB_PENDING
+
+    report_ = Shard_report();
+    report_.workers = workers_;
+    report_.options = static_cast<int>(n);
+    report_.shard_cost.assign(shards.size(), 0.0);
+    report_.shard_seconds.assign(shards.size(), 0.0);
+    for (std::size_t s = 0; s < shards.size(); ++s) {
+        for (std::size_t k = 0; k < shards[s].size(); ++k) report_.shard_cost[s] += cost[shards[s][k]];
+    }
+
+    typedef std::chrono::steady_clock Clock;
+    Clock::time_point start = Clock::now();
+    std::map<pid_t, std::pair<int, Clock::time_point> > running; // pid -> (lot, début de la tentative)
+    std::vector<int> attempts(shards.size(), 0);
+
+    //lance une tentative ; si fork échoue, le lot est résolu dans le coordinateur
+    auto launch = [&](int s) {
+        int crash_after = (s == crash_shard_ && attempts[s] == 0) ? crash_after_ : -1;
+        Clock::time_point t0 = Clock::now();
+        pid_t pid = fork();
+        if (pid == 0) {
+            run_shard(portfolio, shards[s], headers, data, offset, crash_after, crash_hang_);
+            _exit(0);
+        }
+        if (pid < 0) {
+            ++report_.inline_shards;
+            run_shard(portfolio, shards[s], headers, data, offset, -1, false);
+            report_.shard_seconds[s] += std::chrono::duration<double>(Clock::now() - t0).count();
+            return;
+        }
+        running[pid] = std::make_pair(s, t0);
+    };
+
+    for (std::size_t s = 0; s < shards.size(); ++s) {
+        if (!shards[s].empty()) launch(static_cast<int>(s));
+    }
+
+    //on n'attend que nos propres fils (waitpid sur leur pid) : les autres enfants du processus hôte ne sont pas récoltés
+    while (!running.empty()) {
+        std::vector<int> finished;
+        for (std::map<pid_t, std::pair<int, Clock::time_point> >::iterator it = running.begin(); it != running.end();) {
+            int status = 0;
+            pid_t done = waitpid(it->first, &status, WNOHANG);
+            double elapsed = std::chrono::duration<double>(Clock::now() - it->second.second).count();
+            if (done < 0 && errno == EINTR) {
+                ++it;
+                continue;
+            }
+            if (done == 0) {
+                if (attempt_timeout_ <= 0.0 || elapsed < attempt_timeout_) {
+                    ++it;
+                    continue;
+                }
+                //délai dépassé : le processus est tué et la tentative compte comme un échec
+                kill(it->first, SIGKILL);
+                waitpid(it->first, &status, 0);
+                ++report_.timeouts;
+            }
+            report_.shard_seconds[it->second.first] += elapsed;
+            finished.push_back(it->second.first);
+            running.erase(it++);
+        }
+
+        //sortie anormale (signal, exit != 0, délai) ou options restées en attente : relance sur le reste du lot
+        for (std::size_t f = 0; f < finished.size(); ++f) {
+            int s = finished[f];
+            bool pending = false;
+            for (std::size_t k = 0; k < shards[s].size(); ++k) {
+                if (__atomic_load_n(&headers[shards[s][k]].status, __ATOMIC_ACQUIRE) == JOB_PENDING) pending = true;
+            }
+            if (pending && attempts[s] < max_retries_) {
+                ++attempts[s];
+                ++report_.retries;
+                launch(s);
+            }
+        }
+        if (finished.empty()) std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    report_.seconds = std::chrono::duration<double>(Clock::now() - start).count();
+
+    std::vector<Price_slice> slices(n);
+    double cells = 0.0;
+    for (std::size_t j = 0; j < n; ++j) {
+        Price_slice& slice = slices[j];
+        slice.ok = (headers[j].status == JOB_DONE);
+        slice.s_low = slice.ok ? headers[j].s_low : 0.0;
+        slice.dS = slice.ok ? headers[j].dS : 0.0;
+        if (slice.ok) {
+            slice.price.assign(data + offset[j], data + offset[j + 1]);
+            cells += static_cast<double>(portfolio[j].N + 1) * (portfolio[j].M + 1);
+        } else {
+            ++report_.failed;
+        }
+    }
+    munmap(base, bytes);
+
+    if (report_.seconds > 0.0) {
+        report_.options_per_second = (n - report_.failed) / report_.seconds;
+        report_.cells_per_second = cells / report_.seconds;
+    }
+    return slices;
+}
+
+/**
+ * @brief Getter pour le bilan de la dernière exécution
+ * @return Référence vers le bilan
+ */
+const Shard_report& Shard_coordinator::report() const {
+    return report_;
+}
@@ -0,0 +1,131 @@
+/**
+ * @file shard_coordinator.hpp
+ * @author Mathias LE BOUEDEC - Lilou MALFOY
+ * @date 2025
+ * @brief Répartition d'un portefeuille sur plusieurs processus de calcul, résultats en mémoire partagée POSIX
+ */
+
+#ifndef SHARD_COORDINATOR_HPP
+#define SHARD_COORDINATOR_HPP
+
+#include <vector>
+
+
+/**
+ * @brief Option du portefeuille et grille de sa résolution
+ */
+struct Option_spec {
+    bool is_call;  // call ou put européen
+    double K;      // strike
+    double sigma;  // volatilité
+    double r;      // taux sans risque
+    double T;      // maturité
+    double L;      // borne haute du domaine en S
+    int N;         // nombre de points en espace
+    int M;         // nombre de pas de temps
+};
+
+
+/**
+ * @brief Prix à t=0 d'une option sur la grille uniforme en S de sa résolution
+ */
+struct Price_slice {
+    bool ok;                    // false si la résolution a échoué (paramètres invalides ou processus perdu)
+    double s_low;               // premier noeud
+    double dS;                  // pas de la grille
+    std::vector<double> price;  // N+1 prix aux noeuds
+};
+
+
+/**
+ * @brief Bilan de la dernière exécution
+ */
+struct Shard_report {
+    int workers;                        // processus de calcul
+    int options;                        // options du portefeuille
+    int failed;                         // options sans résultat
+    int retries;                        // processus relancés après un échec
+    int timeouts;                       // tentatives tuées pour avoir dépassé le délai
+    int inline_shards;                  // tentatives résolues en série dans le coordinateur faute de fork
+    double seconds;                     // durée totale, du premier fork au dernier résultat
+    double options_per_second;          // débit global
+    double cells_per_second;            // noeuds (N+1)(M+1) résolus par seconde
+    std::vector<double> shard_cost;     // coût estimé de chaque lot (somme des N M)
+    std::vector<double> shard_seconds;  // durée mesurée de chaque lot (tentatives cumulées)
+};
+
+
+/**
+ * @brief Répartition par coût estimé, plus gros d'abord (LPT) : chaque option va au lot le moins chargé
+ * @param cost Coût estimé de chaque option
+ * @param n_shards Nombre de lots
+ * @return Indices des options de chaque lot
+ */
+std::vector< std::vector<int> > balance_shards(const std::vector<double>& cost, int n_shards);
+
+
+/**
+ * @brief Coordinateur local : découpe le portefeuille, lance un processus par lot, relance les échecs
+ *
+ * Chaque lot est résolu par un processus fils (fork) avec Cranck_nicolson ; les tranches à t=0
+ * sont écrites directement dans un segment de mémoire partagée POSIX (shm_open + mmap) créé par le
+ * coordinateur, avec un état par option. Un processus qui se termine anormalement, ou qui dépasse
+ * le délai d'une tentative (il est alors tué), est relancé sur les seules options de son lot encore
+ * sans résultat, au plus max_retries fois. Seuls les processus lancés par le coordinateur sont attendus.
+ * Si fork échoue, le lot est résolu en série dans le coordinateur et compté dans inline_shards :
+ * le débit et l'équilibre du bilan mélangent alors travail parallèle et travail série.
+ * Une option dont la résolution lève une exception est marquée en échec sans relance.
+ */
+class Shard_coordinator {
+private:
+    int workers_;         // nombre de processus de calcul
+    int max_retries_;     // relances maximales par lot
+    int crash_shard_;     // lot dont la première tentative est interrompue (-1 : aucun)
+    int crash_after_;     // options résolues avant l'interruption
+    bool crash_hang_;     // l'interruption bloque le processus au lieu de le tuer
+    double attempt_timeout_; // délai d'une tentative en secondes (0 : aucun)
+    Shard_report report_; // bilan de la dernière exécution
+
+    Shard_coordinator(const Shard_coordinator&);
+    Shard_coordinator& operator=(const Shard_coordinator&);
+
+public:
+    /**
+     * @brief Constructeur
+     * @param workers Nombre de processus de calcul
+     * @param max_retries Relances maximales d'un lot dont le processus a échoué
+     * @throw std::invalid_argument si workers < 1 ou max_retries < 0
+     */
+    Shard_coordinator(int workers, int max_retries = 2);
+
+    /**
+     * @brief Interrompt la première tentative d'un lot (SIGKILL ou blocage) pour vérifier les relances
+     * @param shard Indice du lot (-1 pour désactiver)
+     * @param after_options Nombre d'options résolues avant l'interruption
+     * @param hang true pour bloquer le processus (il sera tué au délai) au lieu de le tuer
+     */
+    void set_fault_injection(int shard, int after_options, bool hang = false);
+
+    /**
+     * @brief Délai d'une tentative : au-delà, le processus est tué et la tentative comptée en échec
+     * @param seconds Délai en secondes (300 par défaut, 0 : aucun)
+     */
+    void set_attempt_timeout(double seconds);
+
+    /**
+     * @brief Résout le portefeuille sur les processus de calcul
+     * @param portfolio Options à résoudre
+     * @return Une tranche par option, dans l'ordre du portefeuille
+     * @throw std::runtime_error si le segment de mémoire partagée ne peut pas être créé
+     */
+    std::vector<Price_slice> run(const std::vector<Option_spec>& portfolio);
+
+    /**
+     * @brief Getter pour le bilan de la dernière exécution
+     * @return Référence vers le bilan
+     */
+    const Shard_report& report() const;
+};
+
+
+#endif // SHARD_COORDINATOR_HPP
@@ -0,0 +1,238 @@
+/**
+ * @file simd_math.cpp
+ * @author Mathias LE BOUEDEC - Lilou MALFOY
+ * @date 2025
+ * @brief Implémentation des noyaux exp et log sur des tableaux
+ */
+
+#include "simd_math.hpp"
+#include <cmath>
+#include <cstring>
+#include <stdint.h>
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+
+namespace {
+
+const double ln2_hi = 6.93147180369123816490e-01;  // ln2, 32 bits de poids fort (n ln2_hi exact)
+const double ln2_lo = 1.90821492927058770002e-10;  // ln2 - ln2_hi
+const int table_bits = 7;                          // 2^(j/128), j = 0..127
+const int table_size = 1 << table_bits;
+const double shifter = 6755399441055744.0;         // 1.5 2^52 : x + shifter arrondit x à l'entier
+const uint64_t shifter_bits = 0x4338000000000000ULL;
+
+/**
+ * @brief Table des 2^(j/128) en deux parties (hi arrondi au double, lo le reste)
+ */
+struct Exp_table {
+    double hi[table_size];
+    double lo[table_size];
+
+    Exp_table() {
+        for (int j = 0; j < table_size; ++j) {
+            long double v = exp2l(static_cast<long double>(j) / table_size);
+            hi[j] = static_cast<double>(v);
+            lo[j] = static_cast<double>(v - hi[j]);
+        }
+    }
+};
+
+/**
+ * @brief Table partagée, construite au premier appel
+ * @return Référence vers la table
+ */
+const Exp_table& exp_table() {
+    static const Exp_table table;
+    return table;
+}
+
+/**
+ * @brief Motif binaire d'un double
+ * @param d Valeur
+ * @return Bits IEEE 754
+ */
+inline uint64_t bits_of(double d) {
+    uint64_t u;
+    std::memcpy(&u, &d, sizeof(u));
+    return u;
+}
+
+/**
+ * @brief Double de motif binaire donné
+ * @param u Bits IEEE 754
+ * @return Valeur
+ */
+inline double double_of(uint64_t u) {
+    double d;
+    std::memcpy(&d, &u, sizeof(d));
+    return d;
+}
+
+/**
+ * @brief Exponentielle sur [-708, 709] sans branchement
+ *
+ * x = (128 n + j) ln2 / 128 + r avec |r| <= ln2 / 256 : exp(x) = 2^n (T_j + T_j expm1(r)),
+ * T_j = 2^(j/128) lu en deux parties, expm1(r) par un polynôme de degré 5 (reste < 1e-18 relatif).
+ * @param x Argument dans [-708, 709]
+ * @param table Table des 2^(j/128)
+ * @return exp(x)
+ */
+inline double exp_kernel(double x, const Exp_table& table) {
+    const double scale = table_size / 6.93147180559945309417e-01;
+    //k = arrondi(128 x / ln2) : ses bits de poids faible sont dans t
+    double t = x * scale + shifter;
+    double k = t - shifter;
+    double r = (x - k * (ln2_hi / table_size)) - k * (ln2_lo / table_size);
+    //k + 1023 128 >= 0 sur l'intervalle retenu : j et n + 1023 par masque et décalage
+    uint64_t kb = bits_of(t) - shifter_bits + 1023ULL * table_size;
+    uint64_t j = kb & (table_size - 1);
+    double two_n = double_of((kb >> table_bits) << 52);
+    double q = r + r * r * (0.5 + r * (1.0 / 6.0 + r * (1.0 / 24.0 + r * (1.0 / 120.0))));
+    double hi = table.hi[j];
+    return (hi + (table.lo[j] + hi * q)) * two_n;
+}
+
+/**
+ * @brief Logarithme d'un double normal positif sans branchement
+ * @param x Argument normal, positif et fini
+ * @return ln(x)
+ */
+inline double log_kernel(double x) {
+    const uint64_t sqrt_half = 0x3fe6a09e667f3bcdULL; // bits de sqrt(1/2)
+    const uint64_t one = 0x3ff0000000000000ULL;        // bits de 1.0
+    const uint64_t magic = 0x4330000000000000ULL;      // bits de 2^52
+    uint64_t u = bits_of(x);
+    //exposant biaisé tel que m = x / 2^k soit dans [sqrt(1/2), sqrt(2)) ; entiers non signés uniquement
+    uint64_t kb = (u - sqrt_half + one) >> 52;
+    double m = double_of(u - ((kb - 1023) << 52));
+    double k = double_of(magic | kb) - 4503599627370496.0 - 1023.0;
+
+    //s = f / (2 + f) avec f = m - 1 (exact), ln m = 2 atanh(s)
+    double f = m - 1.0;
+    double s = f / (2.0 + f);
+    double s2 = s * s;
+    double p = 1.0 / 21.0;
+    p = p * s2 + 1.0 / 19.0;
+    p = p * s2 + 1.0 / 17.0;
+    p = p * s2 + 1.0 / 15.0;
+    p = p * s2 + 1.0 / 13.0;
+    p = p * s2 + 1.0 / 11.0;
+    p = p * s2 + 1.0 / 9.0;
+    p = p * s2 + 1.0 / 7.0;
+    p = p * s2 + 1.0 / 5.0;
+    p = p * s2 + 1.0 / 3.0;
+    //ln m = f - (f^2/2 - s (f^2/2 + R)) avec R = 2 s^2 p : f reste exact, seule la correction est arrondie
+    double hfsq = 0.5 * f * f;
+    double log_m = f - (hfsq - s * (hfsq + 2.0 * s2 * p));
+    //k ln2 en deux parties pour garder la précision près de x = 1
+    return k * ln2_hi + (log_m + k * ln2_lo);
+}
+
+#if defined(__SSE2__)
+/**
+ * @brief exp_kernel sur deux valeurs (SSE2), mêmes opérations dans le même ordre
+ * @param x Arguments dans [-708, 709]
+ * @param table Table des 2^(j/128)
+ * @return exp(x)
+ */
+inline __m128d exp_kernel(__m128d x, const Exp_table& table) {
+    const __m128d sh = _mm_set1_pd(shifter);
+    __m128d t = _mm_add_pd(_mm_mul_pd(x, _mm_set1_pd(table_size / 6.93147180559945309417e-01)), sh);
+    __m128d k = _mm_sub_pd(t, sh);
+    __m128d r = _mm_sub_pd(_mm_sub_pd(x, _mm_mul_pd(k, _mm_set1_pd(ln2_hi / table_size))),
+                           _mm_mul_pd(k, _mm_set1_pd(ln2_lo / table_size)));
+    __m128i kb = _mm_add_epi64(_mm_sub_epi64(_mm_castpd_si128(t), _mm_set1_epi64x(shifter_bits)),
+                               _mm_set1_epi64x(1023LL * table_size));
+    __m128i j = _mm_and_si128(kb, _mm_set1_epi64x(table_size - 1));
+    __m128d two_n = _mm_castsi128_pd(_mm_slli_epi64(_mm_srli_epi64(kb, table_bits), 52));
+    long long j0 = _mm_cvtsi128_si64(j), j1 = _mm_cvtsi128_si64(_mm_unpackhi_epi64(j, j));
+
+    __m128d p = _mm_add_pd(_mm_set1_pd(1.0 / 24.0), _mm_mul_pd(r, _mm_set1_pd(1.0 / 120.0)));
+    p = _mm_add_pd(_mm_set1_pd(1.0 / 6.0), _mm_mul_pd(r, p));
+    p = _mm_add_pd(_mm_set1_pd(0.5), _mm_mul_pd(r, p));
+    __m128d q = _mm_add_pd(r, _mm_mul_pd(_mm_mul_pd(r, r), p));
+    __m128d hi = _mm_set_pd(table.hi[j1], table.hi[j0]);
+    __m128d lo = _mm_set_pd(table.lo[j1], table.lo[j0]);
+    return _mm_mul_pd(_mm_add_pd(hi, _mm_add_pd(lo, _mm_mul_pd(hi, q))), two_n);
+}
+
+/**
+ * @brief log_kernel sur deux valeurs (SSE2), mêmes opérations dans le même ordre
+ * @param x Arguments normaux, positifs et finis
+ * @return ln(x)
+ */
+inline __m128d log_kernel(__m128d x) {
+    __m128i u = _mm_castpd_si128(x);
+    __m128i kb = _mm_srli_epi64(_mm_add_epi64(_mm_sub_epi64(u, _mm_set1_epi64x(0x3fe6a09e667f3bcdLL)),
+                                              _mm_set1_epi64x(0x3ff0000000000000LL)), 52);
+    __m128d m = _mm_castsi128_pd(_mm_sub_epi64(u, _mm_slli_epi64(_mm_sub_epi64(kb, _mm_set1_epi64x(1023)), 52)));
+    __m128d k = _mm_sub_pd(_mm_sub_pd(_mm_castsi128_pd(_mm_or_si128(_mm_set1_epi64x(0x4330000000000000LL), kb)),
+                                      _mm_set1_pd(4503599627370496.0)), _mm_set1_pd(1023.0));
+
+    __m128d f = _mm_sub_pd(m, _mm_set1_pd(1.0));
+    __m128d s = _mm_div_pd(f, _mm_add_pd(_mm_set1_pd(2.0), f));
+    __m128d s2 = _mm_mul_pd(s, s);
+    static const double c[] = {1.0 / 19.0, 1.0 / 17.0, 1.0 / 15.0, 1.0 / 13.0, 1.0 / 11.0,
+                               1.0 / 9.0, 1.0 / 7.0, 1.0 / 5.0, 1.0 / 3.0};
+    __m128d p = _mm_set1_pd(1.0 / 21.0);
+    for (int q = 0; q < 9; ++q) p = _mm_add_pd(_mm_mul_pd(p, s2), _mm_set1_pd(c[q]));
+    __m128d hfsq = _mm_mul_pd(_mm_mul_pd(_mm_set1_pd(0.5), f), f);
+    __m128d R = _mm_mul_pd(_mm_mul_pd(_mm_set1_pd(2.0), s2), p);
+    __m128d log_m = _mm_sub_pd(f, _mm_sub_pd(hfsq, _mm_mul_pd(s, _mm_add_pd(hfsq, R))));
+    return _mm_add_pd(_mm_mul_pd(k, _mm_set1_pd(ln2_hi)), _mm_add_pd(log_m, _mm_mul_pd(k, _mm_set1_pd(ln2_lo))));
+}
+#endif
+
+} // namespace
+
+
+/**
+ * @brief Exponentielle d'un tableau, erreur inférieure à 1 ULP
+ * @param x Arguments
+ * @param y Résultats (peut être égal à x)
+ * @param n Nombre de valeurs
+ */
+void vector_exp(const double* x, double* y, std::size_t n) {
+    const double lo = -708.0, hi = 709.0;
+    bool special = false;
+    for (std::size_t i = 0; i < n; ++i) special |= !(x[i] >= lo && x[i] <= hi);
+    const Exp_table& table = exp_table();
+    if (!special) {
+        std::size_t i = 0;
+#if defined(__SSE2__)
+        for (; i + 2 <= n; i += 2) _mm_storeu_pd(y + i, exp_kernel(_mm_loadu_pd(x + i), table));
+#endif
+        for (; i < n; ++i) y[i] = exp_kernel(x[i], table);
+        return;
+    }
+    //dépassement, sous-normaux, infinis ou NaN : valeur par valeur
+    for (std::size_t i = 0; i < n; ++i) {
+        y[i] = (x[i] >= lo && x[i] <= hi) ? exp_kernel(x[i], table) : std::exp(x[i]);
+    }
+}
+
+/**
+ * @brief Logarithme népérien d'un tableau, erreur inférieure à 2 ULP
+ * @param x Arguments
+ * @param y Résultats (peut être égal à x)
+ * @param n Nombre de valeurs
+ */
+void vector_log(const double* x, double* y, std::size_t n) {
+    const double min_normal = 2.2250738585072014e-308, max_double = 1.7976931348623157e308;
+    bool special = false;
+    for (std::size_t i = 0; i < n; ++i) special |= !(x[i] >= min_normal && x[i] <= max_double);
+    if (!special) {
+        std::size_t i = 0;
+#if defined(__SSE2__)
+        for (; i + 2 <= n; i += 2) _mm_storeu_pd(y + i, log_kernel(_mm_loadu_pd(x + i)));
+#endif
+        for (; i < n; ++i) y[i] = log_kernel(x[i]);
+        return;
+    }
+    //0, négatifs, sous-normaux, infinis ou NaN : valeur par valeur
+    for (std::size_t i = 0; i < n; ++i) {
+        y[i] = (x[i] >= min_normal && x[i] <= max_double) ? log_kernel(x[i]) : std::log(x[i]);
+    }
+}
@@ -7,9 +7,14 @@
 
 
 #include "solver.hpp"
+#include "workspace.hpp"
+#include "simd_math.hpp"
 #include <algorithm>
+#include <chrono>
 #include <cmath>
 #include <iostream>
+#include <stdexcept>
+#include <thread>
 
 
 /**
@@ -18,16 +23,725 @@
  * @param N Nombre de points en espace
  * @param M Nombre de points en temps
  */
-Solver::Solver(EDP& edp, int N, int M) : edp_(edp), N_(N), M_(M) {  
+Solver::Solver(EDP& edp, int N, int M)
+    : edp_(edp), N_(N), M_(M), M_config_(M), domain_low_(0.0), domain_high_(edp.getL()), smoothing_(false), alignment_(ALIGN_NONE),
+      scheme_(SCHEME_CRANK_NICOLSON), rannacher_steps_(2), adaptive_tol_(0.0), rejected_steps_(0),
+      parareal_slices_(0), parareal_threads_(0), parareal_coarse_steps_(2), parareal_tol_(1e-6),
+      progress_(nullptr), progress_user_(nullptr), progress_every_(16), stepper_(N) {  
     dt_ = edp_.getT() / static_cast<double>(M_); //pas de temps
-    dS_ = edp_.getL() / static_cast<double>(N_); //pas en espace
+    parareal_stats_ = Parareal_stats();
 
-    S_.resize(N_ + 1);
+    //grilles, matrice des solutions et tampons empruntés au pool du thread (recyclés entre solveurs)
+    Workspace_pool& pool = Workspace_pool::local();
+    pool.acquire(N_ + 1, S_);
+    pool.acquire(M_ + 1, t_);
+    pool.acquire(M_ + 1, N_ + 1, v_);
+    pool.acquire(N_ + 1, op_.lower);
+    pool.acquire(N_ + 1, op_.diag);
+    pool.acquire(N_ + 1, op_.upper);
+    pool.acquire(N_ + 1, stage_);
+    std::size_t n_size = (N_ > 1) ? N_ - 1 : 1;
+    pool.acquire(n_size, cp_);
+    pool.acquire(n_size, dp_);
+
+    build_grid();
+    for (int j = 0; j <= M_; ++j) t_[j] = j * dt_;
+    for (int j = 0; j <= M_; ++j) std::fill(v_[j].begin(), v_[j].end(), 0.0);
+}
+
+/**
+ * @brief Destructeur virtuel de la classe Solver (rend la mémoire au pool du thread)
+ */
+Solver::~Solver() {
+    Workspace_pool& pool = Workspace_pool::local();
+    pool.release(S_);
+    pool.release(t_);
+    pool.release(v_);
+    pool.release(op_.lower);
+    pool.release(op_.diag);
+    pool.release(op_.upper);
+    for (std::size_t p = 0; p < piece_ops_.size(); ++p) {
+        pool.release(piece_ops_[p].lower);
+        pool.release(piece_ops_[p].diag);
+        pool.release(piece_ops_[p].upper);
+    }
+    pool.release(stage_);
+    pool.release(cp_);
+    pool.release(dp_);
+}
+
+/**
+ * @brief Remplit op_ avec les constantes de l'EDP et, avec une structure par terme, un opérateur par morceau
+ */
+void Solver::build_operator() {
+    fill_operator(edp_.getR(), edp_.getSigma(), op_);
+
+    Workspace_pool& pool = Workspace_pool::local();
+    for (std::size_t p = 0; p < piece_ops_.size(); ++p) {
+        pool.release(piece_ops_[p].lower);
+        pool.release(piece_ops_[p].diag);
+        pool.release(piece_ops_[p].upper);
+    }
+    piece_ops_.clear();
+    piece_tau_.clear();
+    if (!edp_.has_term_structure()) return;
+
+    //les dates de changement, en temps calendaire, découpent [0, T] en morceaux ; tau croît quand t décroît
+    const double T = edp_.getT();
+    std::vector<double> dates = edp_.breakpoints();
+    piece_tau_.push_back(0.0);
+    for (std::size_t k = dates.size(); k-- > 0;) piece_tau_.push_back(T - dates[k]);
+
+    piece_ops_.resize(piece_tau_.size());
+    for (std::size_t p = 0; p < piece_ops_.size(); ++p) {
+        double tau_end = (p + 1 < piece_tau_.size()) ? piece_tau_[p + 1] : T;
+        double t = T - 0.5 * (piece_tau_[p] + tau_end);
+        pool.acquire(N_ + 1, piece_ops_[p].lower);
+        pool.acquire(N_ + 1, piece_ops_[p].diag);
+        pool.acquire(N_ + 1, piece_ops_[p].upper);
+        fill_operator(edp_.getR(t), edp_.getSigma(t), piece_ops_[p]);
+    }
+}
+
+/**
+ * @brief Opérateur en vigueur au temps avant maturité tau
+ * @param tau Temps avant maturité
+ * @return Opérateur du morceau contenant tau (op_ sans structure par terme)
+ */
+const Tridiagonal_operator& Solver::operator_at(double tau) const {
+    if (piece_ops_.empty()) return op_;
+    std::size_t p = std::upper_bound(piece_tau_.begin(), piece_tau_.end(), tau) - piece_tau_.begin();
+    return piece_ops_[(p > 0) ? p - 1 : 0];
+}
+
+/**
+ * @brief Donne au pas de temps l'opérateur en vigueur en tau ; ses factorisations ne sont
+ * recalculées qu'au changement de morceau
+ * @param stepper Pas de temps
+ * @param tau Temps avant maturité (milieu du pas)
+ */
+void Solver::select_operator(Time_stepper& stepper, double tau) const {
+    const Tridiagonal_operator& op = operator_at(tau);
+    if (stepper.get_operator() != &op) stepper.set_operator(op);
+}
+
+/**
+ * @brief Temps avant maturité des lignes de la marche, chaque date de changement de la structure
+ * par terme et chaque temps de node_tau_ étant déplacé sur le noeud le plus proche
+ * @param taus Vecteur des M+1 temps, croissants
+ * @throw std::invalid_argument si deux temps de node_tau_ tombent sur le même noeud
+ */
+void Solver::march_times(std::vector<double>& taus) const {
+    taus.resize(M_ + 1);
+    for (int k = 0; k <= M_; ++k) taus[k] = k * dt_;
+    for (std::size_t p = 1; p < piece_tau_.size(); ++p) {
+        int k = static_cast<int>(std::floor(piece_tau_[p] / dt_ + 0.5));
+        if (k > 0 && k < M_) taus[k] = piece_tau_[p];
+    }
+
+    std::vector<bool> taken(M_ + 1, false);
+    for (std::size_t m = 0; m < node_tau_.size(); ++m) {
+        int k = static_cast<int>(std::floor(node_tau_[m] / dt_ + 0.5));
+        k = std::min(std::max(k, 1), M_); //le noeud 0 porte la condition initiale
+        if (taken[k]) throw std::invalid_argument("Solver : deux temps sur le même noeud, augmenter M");
+        taken[k] = true;
+        if (k < M_) taus[k] = node_tau_[m];
+    }
+}
+
+/**
+ * @brief Construit la grille uniforme en S sur [0, L_] selon l'alignement demandé
+ */
+void Solver::build_grid() {
+    L_ = domain_high_;
+    double barrier = edp_.getOption()->upper_barrier();
+
+    if (barrier <= L_) {
+        //option à barrière : le domaine s'arrête exactement sur la barrière (dernier noeud)
+        L_ = barrier;
+    } else if (alignment_ != ALIGN_NONE) {
+        //on ajuste le pas pour que K = m * dS avec m entier (noeud) ou demi-entier (milieu de maille)
+        double K = edp_.getOption()->getK();
+        double m = K / (L_ / static_cast<double>(N_));
+        if (m >= 1.0 && m < N_) {
+            double m_aligned = (alignment_ == ALIGN_NODE) ? std::floor(m + 0.5) : std::floor(m) + 0.5;
+            L_ = N_ * K / m_aligned;
+        }
+    }
+
+    dS_ = L_ / static_cast<double>(N_); //pas en espace
     for (int i = 0; i <= N_; ++i) S_[i] = i * dS_;
+}
+
+/**
+ * @brief Bornes en S réellement utilisées par le solveur (là où les conditions de Dirichlet s'appliquent à t=0)
+ * @param s_low Borne basse (0 : pas de bord bas)
+ * @param s_high Borne haute
+ */
+void Solver::domain_bounds(double& s_low, double& s_high) const {
+    s_low = 0.0;
+    s_high = L_;
+}
+
+/**
+ * @brief Fixe le domaine de calcul à la place du L de l'EDP
+ * @param s_low Borne basse (ignorée par Crank-Nicolson dont la grille part de 0)
+ * @param s_high Borne haute
+ */
+void Solver::set_domain(double s_low, double s_high) {
+    if (!(s_high > s_low) || s_low < 0.0 || !std::isfinite(s_high)) {
+        throw std::invalid_argument("Solver : domaine vide, infini ou borne basse négative");
+    }
+    domain_low_ = s_low;
+    domain_high_ = s_high;
+    build_grid();
+}
+
+/**
+ * @brief Choisit le domaine à n_std écarts-types en log-prix autour des spots et du strike
+ * @param spots Prix de l'actif où l'on veut le prix
+ * @param n_std Nombre d'écarts-types sigma sqrt(T) de chaque côté
+ * @return Domaine choisi, avec l'erreur de bord estimée pour ce solveur
+ */
+Domain Solver::set_auto_domain(const std::vector<double>& spots, double n_std) {
+    Domain domain = choose_domain(edp_, spots, n_std);
+    set_domain(domain.s_low, domain.s_high);
+    //l'alignement peut avoir déplacé L_ et Crank-Nicolson n'a pas de bord bas : on réévalue
+    domain_bounds(domain.s_low, domain.s_high);
+    domain.boundary_error = boundary_error(spots.empty() ? std::vector<double>(1, edp_.getOption()->getK()) : spots);
+    return domain;
+}
+
+/**
+ * @brief Erreur estimée sur les prix aux spots due aux conditions aux bords du domaine courant
+ * @param spots Prix de l'actif où l'on veut le prix
+ * @return Borne P(toucher le bord) x (écart de la condition au bord)
+ */
+double Solver::boundary_error(const std::vector<double>& spots) const {
+    double s_low, s_high;
+    domain_bounds(s_low, s_high);
+    return boundary_error_estimate(edp_, s_low, s_high, spots);
+}
+
+/**
+ * @brief Active le lissage du payoff (moyenne sur chaque maille au lieu de la valeur au noeud)
+ * @param on true pour activer
+ */
+void Solver::set_payoff_smoothing(bool on) {
+    smoothing_ = on;
+}
+
+/**
+ * @brief Choisit le placement du strike sur la grille
+ * @param alignment ALIGN_NONE, ALIGN_NODE ou ALIGN_MIDPOINT
+ */
+void Solver::set_grid_alignment(Grid_alignment alignment) {
+    alignment_ = alignment;
+    build_grid();
+}
+
+/**
+ * @brief Getter pour la grille en espace
+ * @return Vecteur des prix de l'actif aux noeuds
+ */
+std::vector<double> Solver::get_grid() const {
+    return S_;
+}
+
+/**
+ * @brief Choisit le schéma en temps
+ * @param scheme SCHEME_CRANK_NICOLSON, SCHEME_IMPLICIT, SCHEME_RANNACHER, SCHEME_BDF2 ou SCHEME_TR_BDF2
+ * @param rannacher_steps Nombre de pas de démarrage implicites (Rannacher)
+ */
+void Solver::set_time_scheme(Time_scheme scheme, int rannacher_steps) {
+    scheme_ = scheme;
+    rannacher_steps_ = std::max(rannacher_steps, 0);
+}
+
+/**
+ * @brief Getter pour le schéma en temps
+ * @return Schéma utilisé par solve()
+ */
+Time_scheme Solver::get_time_scheme() const {
+    return scheme_;
+}
+
+/**
+ * @brief Active le pas de temps adaptatif (estimation de l'erreur locale par doublement de pas)
+ * @param tolerance Erreur locale maximale tolérée par pas (norme max), 0 pour revenir au pas fixe
+ */
+void Solver::set_adaptive(double tolerance) {
+    adaptive_tol_ = std::max(tolerance, 0.0);
+}
+
+/**
+ * @brief Accès sans copie à la matrice des solutions (lisible pendant solve() depuis le suivi)
+ * @return Référence vers la matrice des solutions
+ */
+const std::vector< std::vector<double> >& Solver::get_surface() const {
+    return v_;
+}
+
+/**
+ * @brief Définit une fonction appelée pendant la marche en temps quand des lignes sont prêtes
+ * @param callback Fonction de suivi (nullptr pour désactiver)
+ * @param user Pointeur transmis à la fonction
+ * @param every Nombre de pas entre deux appels
+ */
+void Solver::set_progress_callback(Progress_callback callback, void* user, int every) {
+    progress_ = callback;
+    progress_user_ = user;
+    progress_every_ = std::max(every, 1);
+}
+
+/**
+ * @brief Appelle le suivi de la marche s'il est défini
+ * @param row_begin Première ligne prête
+ * @param row_end Ligne suivant la dernière ligne prête
+ */
+void Solver::notify_progress(int row_begin, int row_end) {
+    if (progress_ != nullptr) progress_(progress_user_, row_begin, row_end);
+}
+
+/**
+ * @brief Active le mode parareal (parallèle en temps) pour les marches longues
+ * @param n_slices Nombre de tranches en temps (0 ou 1 pour revenir à la marche série)
+ * @param tolerance Correction maximale aux bords des tranches pour arrêter les itérations
+ * @param n_threads Nombre de threads (0 : nombre de coeurs)
+ * @param coarse_steps Pas d'Euler implicite du propagateur grossier par tranche
+ */
+void Solver::set_parareal(int n_slices, double tolerance, int n_threads, int coarse_steps) {
+    parareal_slices_ = std::max(n_slices, 0);
+    parareal_tol_ = std::max(tolerance, 0.0);
+    parareal_threads_ = std::max(n_threads, 0);
+    parareal_coarse_steps_ = std::max(coarse_steps, 1);
+}
+
+/**
+ * @brief Getter pour le bilan du dernier solve() en mode parareal
+ * @return Itérations, correction finale et accélération du modèle de travail
+ */
+Parareal_stats Solver::get_parareal_stats() const {
+    return parareal_stats_;
+}
+
+/**
+ * @brief Getter pour la grille en temps (non uniforme en mode adaptatif)
+ * @return Vecteur des temps associés aux lignes de la matrice des solutions
+ */
+std::vector<double> Solver::get_times() const {
+    return t_;
+}
+
+/**
+ * @brief Getter pour le nombre de pas rejetés par le contrôleur adaptatif
+ * @return Nombre de pas rejetés lors du dernier solve()
+ */
+int Solver::get_rejected_steps() const {
+    return rejected_steps_;
+}
+
+/**
+ * @brief Avance d'un pas avec un schéma à un pas
+ * @param u_old Solution au temps tau_old
+ * @param u_new Solution au temps tau_old + dt (les bords sont fixés ici)
+ * @param tau_old Temps avant maturité au début du pas
+ * @param dt Pas de temps
+ * @param scheme SCHEME_CRANK_NICOLSON, SCHEME_IMPLICIT, SCHEME_TR_BDF2, ou SCHEME_RANNACHER pour deux demi-pas implicites
+ */
+void Solver::one_step(const std::vector<double>& u_old, std::vector<double>& u_new, double tau_old, double dt, Time_scheme scheme) {
+    one_step(stepper_, stage_, u_old, u_new, tau_old, dt, scheme);
+}
+
+/**
+ * @brief Même pas que one_step avec un pas de temps et une étape fournis (sûr entre threads)
+ * @param stepper Pas de temps utilisé (un par thread)
+ * @param stage Étape intermédiaire de taille N+1 (un par thread)
+ * @param u_old Solution au temps tau_old
+ * @param u_new Solution au temps tau_old + dt (les bords sont fixés ici)
+ * @param tau_old Temps avant maturité au début du pas
+ * @param dt Pas de temps
+ * @param scheme SCHEME_CRANK_NICOLSON, SCHEME_IMPLICIT, SCHEME_TR_BDF2, ou SCHEME_RANNACHER pour deux demi-pas implicites
+ */
+void Solver::one_step(Time_stepper& stepper, std::vector<double>& stage, const std::vector<double>& u_old, std::vector<double>& u_new,
+                      double tau_old, double dt, Time_scheme scheme) const {
+    select_operator(stepper, tau_old + 0.5 * dt);
+    boundary_values(tau_old + dt, u_new[0], u_new[N_]);
+
+    if (scheme == SCHEME_RANNACHER) {
+        //deux demi-pas implicites amortissent le coude du payoff
+        boundary_values(tau_old + 0.5 * dt, stage[0], stage[N_]);
+        stepper.theta_step(u_old, stage, 0.5 * dt, 1.0);
+        stepper.theta_step(stage, u_new, 0.5 * dt, 1.0);
+    } else if (scheme == SCHEME_TR_BDF2) {
+        boundary_values(tau_old + Time_stepper::tr_bdf2_gamma() * dt, stage[0], stage[N_]);
+        stepper.tr_bdf2_step(u_old, stage, u_new, dt);
+    } else {
+        stepper.theta_step(u_old, u_new, dt, scheme == SCHEME_IMPLICIT ? 1.0 : 0.5);
+    }
+}
+
+/**
+ * @brief Marche en tau de 0 à T avec le schéma choisi, la condition initiale étant déjà en place
+ * @param backward_rows true si tau = k dt est stocké à la ligne M-k (temps calendaire), false pour la ligne k
+ */
+void Solver::time_march(bool backward_rows) {
+    restore_time_grid(backward_rows);
+    build_operator();
+    stepper_.set_operator(op_);
+    rejected_steps_ = 0;
+
+    if (adaptive_tol_ > 0.0) {
+        adaptive_march(backward_rows);
+        notify_progress(0, M_ + 1);
+        return;
+    }
+
+    //structure par terme : les dates de changement sont sur des noeuds, aucun pas ne chevauche deux morceaux
+    std::vector<double>& taus = march_tau_;
+    taus.clear();
+    if (!piece_ops_.empty() || !node_tau_.empty()) march_times(taus);
+
+    if (parareal_slices_ > 1 && M_ > 1) {
+        parareal_march(backward_rows);
+        store_march_times(backward_rows);
+        notify_progress(0, M_ + 1);
+        return;
+    }
+
+    for (int k = 1; k <= M_; ++k) {
+        std::vector<double>& u_old = v_[backward_rows ? M_ - k + 1 : k - 1];
+        std::vector<double>& u_new = v_[backward_rows ? M_ - k : k];
+        double tau_old = taus.empty() ? (k - 1) * dt_ : taus[k - 1];
+        double dt = taus.empty() ? dt_ : taus[k] - taus[k - 1];
+
+        //Rannacher et démarrage de BDF2 : deux demi-pas implicites
+        bool implicit_start = (scheme_ == SCHEME_RANNACHER && k <= rannacher_steps_) || (scheme_ == SCHEME_BDF2 && k == 1);
+
+        //BDF2 suppose deux pas égaux sous le même opérateur : aux dates de changement de la structure
+        //par terme, on repart d'un pas TR-BDF2 (à un pas, du même ordre)
+        bool bdf2_restart = scheme_ == SCHEME_BDF2 && !taus.empty() && k > 1
+            && (dt != taus[k - 1] - taus[k - 2] || &operator_at(tau_old + 0.5 * dt) != &operator_at(tau_old - 0.5 * dt));
+
+        if (implicit_start) {
+            one_step(u_old, u_new, tau_old, dt, SCHEME_RANNACHER);
+        } else if (bdf2_restart) {
+            one_step(u_old, u_new, tau_old, dt, SCHEME_TR_BDF2);
+        } else if (scheme_ == SCHEME_BDF2) {
+            const std::vector<double>& u_older = v_[backward_rows ? M_ - k + 2 : k - 2];
+            select_operator(stepper_, tau_old + 0.5 * dt);
+            boundary_values(taus.empty() ? k * dt_ : taus[k], u_new[0], u_new[N_]);
+            stepper_.bdf2_step(u_old, u_older, u_new, dt);
+        } else {
+            one_step(u_old, u_new, tau_old, dt, scheme_ == SCHEME_RANNACHER ? SCHEME_CRANK_NICOLSON : scheme_);
+        }
+
+        //suivi : lignes calculées depuis le dernier appel (la condition initiale est prête dès le premier)
+        if (progress_ != nullptr && (k % progress_every_ == 0 || k == M_)) {
+            int done_begin = std::max(k - progress_every_ + 1, 0);
+            if (done_begin == 1) done_begin = 0;
+            if (backward_rows) notify_progress(M_ - k, M_ - done_begin + 1);
+            else notify_progress(done_begin, k + 1);
+        }
+    }
+
+    store_march_times(backward_rows);
+}
+
+/**
+ * @brief Recopie dans t_ les temps de la marche quand des noeuds ont été déplacés sur les dates de changement
+ * @param backward_rows même convention de stockage que time_march
+ */
+void Solver::store_march_times(bool backward_rows) {
+    for (int k = 0; k < static_cast<int>(march_tau_.size()); ++k) {
+        if (backward_rows) t_[M_ - k] = edp_.getT() - march_tau_[k];
+        else t_[k] = march_tau_[k];
+    }
+}
+
+/**
+ * @brief Remet la grille en temps uniforme de M_config_ pas après une marche adaptative, condition initiale conservée
+ * @param backward_rows même convention de stockage que time_march
+ */
+void Solver::restore_time_grid(bool backward_rows) {
+    if (M_ == M_config_) return;
+    Workspace_pool& pool = Workspace_pool::local();
+
+    //la condition initiale passe dans un tampon le temps de rendre la matrice au pool
+    std::vector<double> initial;
+    pool.acquire(N_ + 1, initial);
+    initial.swap(v_[backward_rows ? M_ : 0]);
+    pool.release(v_);
+
+    M_ = M_config_;
+    dt_ = edp_.getT() / static_cast<double>(M_);
+    pool.acquire(M_ + 1, N_ + 1, v_);
+    for (int j = 0; j <= M_; ++j) std::fill(v_[j].begin(), v_[j].end(), 0.0);
+    v_[backward_rows ? M_ : 0].swap(initial);
+    pool.release(initial);
     t_.resize(M_ + 1);
     for (int j = 0; j <= M_; ++j) t_[j] = j * dt_;
+}
+
+/**
+ * @brief Marche adaptative : chaque pas est comparé à deux demi-pas, le pas grandit ou diminue selon l'erreur
+ * @param backward_rows même convention de stockage que time_march
+ */
+void Solver::adaptive_march(bool backward_rows) {
+    const double T = edp_.getT();
+    const double dt_base = T / static_cast<double>(M_config_); //le pas initial est T/M ; les pas restent de la forme dt_base * 2^k
+
+    //les schémas multi-pas ou à démarrage spécial sont remplacés par TR-BDF2 (même ordre, L-stable)
+    Time_scheme scheme = (scheme_ == SCHEME_BDF2 || scheme_ == SCHEME_RANNACHER) ? SCHEME_TR_BDF2 : scheme_;
+    double order = (scheme == SCHEME_IMPLICIT) ? 1.0 : 2.0;
+    double richardson = std::pow(2.0, order) - 1.0;
 
-    v_.resize(M_ + 1, std::vector<double>(N_ + 1, 0.0));
+    Workspace_pool& pool = Workspace_pool::local();
+    std::vector<double> u_full, u_mid;
+    pool.acquire(N_ + 1, u_full);
+    pool.acquire(N_ + 1, u_mid);
+
+    //niveaux acceptés, en tau croissant
+    std::vector< std::vector<double> > levels(1);
+    levels[0].swap(v_[backward_rows ? M_ : 0]);
+    std::vector<double> taus(1, 0.0);
+
+    double tau = 0.0;
+    int level = 0; // dt = dt_base * 2^level
+    while (tau < T * (1.0 - 1e-12)) {
+        double dt = std::min(dt_base * std::ldexp(1.0, level), T - tau);
+
+        //structure par terme : le pas s'arrête à la date de changement suivante (sinon le pas complet
+        //et le premier demi-pas peuvent prendre le même mauvais morceau et l'estimation d'erreur ne le voit pas)
+        std::vector<double>::const_iterator next = std::upper_bound(piece_tau_.begin(), piece_tau_.end(), tau + T * 1e-12);
+        if (next != piece_tau_.end()) dt = std::min(dt, *next - tau);
+        const std::vector<double>& u_old = levels.back();
+
+        //un pas complet et deux demi-pas
+        one_step(u_old, u_full, tau, dt, scheme);
+        one_step(u_old, u_mid, tau, 0.5 * dt, scheme);
+        std::vector<double> u_new;
+        pool.acquire(N_ + 1, u_new);
+        one_step(u_mid, u_new, tau + 0.5 * dt, 0.5 * dt, scheme);
+
+        //estimation de l'erreur locale (Richardson) en norme max
+        double err = 0.0;
+        for (int i = 1; i < N_; ++i) err = std::max(err, std::abs(u_new[i] - u_full[i]));
+        err /= richardson;
+
+        //facteur de pas classique, borné, puis arrondi à une puissance de 2 inférieure : les pas se répètent
+        double factor = (err > 0.0) ? 0.9 * std::pow(adaptive_tol_ / err, 1.0 / (order + 1.0)) : 4.0;
+        factor = std::min(4.0, std::max(0.2, factor));
+        int new_level = level + static_cast<int>(std::floor(std::log2(factor)));
+
+        if (err <= adaptive_tol_ || dt < T * 1e-10) {
+            levels.push_back(std::vector<double>());
+            levels.back().swap(u_new);
+            tau += dt;
+            taus.push_back(tau);
+            level = std::min(new_level, level + 2);
+        } else {
+            pool.release(u_new);
+            rejected_steps_++;
+            level = std::min(new_level, level - 1);
+        }
+    }
+    pool.release(u_full);
+    pool.release(u_mid);
+
+    //la grille en temps choisie remplace la grille uniforme
+    pool.release(v_);
+    M_ = static_cast<int>(levels.size()) - 1;
+    t_.resize(M_ + 1);
+    v_.resize(M_ + 1);
+    for (int k = 0; k <= M_; ++k) {
+        int row = backward_rows ? M_ - k : k;
+        v_[row].swap(levels[k]);
+        t_[row] = backward_rows ? T - taus[k] : taus[k];
+    }
+    dt_ = T / static_cast<double>(M_); //pas moyen
+}
+
+/**
+ * @brief Propagateur grossier de parareal : pas d'Euler implicite sur une tranche
+ * @param start Premier pas fin de chaque tranche
+ * @param n Indice de la tranche
+ * @param u_start Solution au début de la tranche
+ * @param u_end Solution à la fin de la tranche
+ * @param mid Tampon pour les pas intermédiaires
+ */
+void Solver::coarse_propagate(const std::vector<int>& start, int n, const std::vector<double>& u_start,
+                              std::vector<double>& u_end, std::vector<double>& mid) {
+    const int n_coarse = parareal_coarse_steps_;
+    double tau = march_tau_.empty() ? start[n] * dt_ : march_tau_[start[n]];
+    double tau_end = march_tau_.empty() ? start[n + 1] * dt_ : march_tau_[start[n + 1]];
+    double h = march_tau_.empty() ? (start[n + 1] - start[n]) * dt_ / n_coarse : (tau_end - tau) / n_coarse;
+    const std::vector<double>* src = &u_start;
+    for (int c = 0; c < n_coarse; ++c) {
+        std::vector<double>& dst = ((n_coarse - 1 - c) % 2 == 0) ? u_end : mid; //le dernier pas écrit dans u_end
+        one_step(*src, dst, tau + c * h, h, SCHEME_IMPLICIT);
+        src = &dst;
+    }
+}
+
+/**
+ * @brief Marche parareal : propagateur grossier série (Euler implicite à grands pas),
+ * propagateurs fins concurrents sur les tranches, corrigés jusqu'à la tolérance
+ * @param backward_rows même convention de stockage que time_march
+ */
+void Solver::parareal_march(bool backward_rows) {
+    std::chrono::steady_clock::time_point t0 = std::chrono::steady_clock::now();
+    const int P = std::min(parareal_slices_, M_);
+    const int n_coarse = parareal_coarse_steps_;
+    int n_threads = (parareal_threads_ > 0) ? parareal_threads_ : static_cast<int>(std::thread::hardware_concurrency());
+    n_threads = std::max(1, std::min(n_threads, P));
+
+    //la tranche n couvre les pas start[n]+1 .. start[n+1] ; BDF2 (multi-pas) devient TR-BDF2 sur chaque tranche
+    std::vector<int> start(P + 1);
+    for (int n = 0; n <= P; ++n) start[n] = static_cast<int>(static_cast<long>(n) * M_ / P);
+    const Time_scheme fine = (scheme_ == SCHEME_BDF2) ? SCHEME_TR_BDF2 : scheme_;
+
+    //un pas de temps et une étape par thread : les factorisations sont calculées une fois par thread et par itération
+    std::vector<Time_stepper> steppers(n_threads, stepper_);
+    Workspace_pool& pool = Workspace_pool::local();
+    std::vector< std::vector<double> > stages(n_threads), fine_end(P), coarse_old(P);
+    std::vector<double> coarse_new, coarse_mid;
+    for (int id = 0; id < n_threads; ++id) {
+        steppers[id].set_operator(op_);
+        pool.acquire(N_ + 1, stages[id]);
+    }
+    for (int n = 0; n < P; ++n) {
+        pool.acquire(N_ + 1, fine_end[n]);
+        pool.acquire(N_ + 1, coarse_old[n]);
+    }
+    pool.acquire(N_ + 1, coarse_new);
+    pool.acquire(N_ + 1, coarse_mid);
+
+    //première estimation aux bords des tranches par le seul propagateur grossier
+    for (int n = 0; n < P; ++n) {
+        coarse_propagate(start, n, v_[backward_rows ? M_ - start[n] : start[n]], coarse_old[n], coarse_mid);
+        v_[backward_rows ? M_ - start[n + 1] : start[n + 1]] = coarse_old[n];
+    }
+    double critical_steps = P * n_coarse; //chemin critique du modèle de travail (un pas grossier ~ un pas fin)
+
+    int first = 0; //les tranches avant first partent d'une valeur exacte, leur propagation fine est acquise
+    int iterations = 0;
+    double correction = 0.0;
+    while (first < P) {
+        //propagateurs fins concurrents ; la tranche n écrit ses lignes intérieures et fine_end[n], jamais son bord de départ
+        std::vector<std::thread> workers;
+        for (int id = 0; id < n_threads; ++id) {
+            workers.push_back(std::thread([this, id, n_threads, first, P, fine, backward_rows, &start, &steppers, &stages, &fine_end]() {
+                for (int n = first + id; n < P; n += n_threads) {
+                    const std::vector<double>* u_old = &v_[backward_rows ? M_ - start[n] : start[n]];
+                    for (int j = start[n] + 1; j <= start[n + 1]; ++j) {
+                        std::vector<double>& u_new = (j == start[n + 1]) ? fine_end[n] : v_[backward_rows ? M_ - j : j];
+                        Time_scheme scheme = fine;
+                        if (fine == SCHEME_RANNACHER) scheme = (j <= rannacher_steps_) ? SCHEME_RANNACHER : SCHEME_CRANK_NICOLSON;
+                        if (march_tau_.empty()) one_step(steppers[id], stages[id], *u_old, u_new, (j - 1) * dt_, dt_, scheme);
+                        else one_step(steppers[id], stages[id], *u_old, u_new, march_tau_[j - 1], march_tau_[j] - march_tau_[j - 1], scheme);
+                        u_old = &u_new;
+                    }
+                }
+                //les factorisations ont été empruntées au pool de ce thread : elles y retournent avant sa fin
+                steppers[id].release_factorizations();
+            }));
+        }
+        for (std::size_t i = 0; i < workers.size(); ++i) workers[i].join();
+
+        //coût du thread le plus chargé
+        double busiest = 0.0;
+        for (int id = 0; id < n_threads; ++id) {
+            double steps = 0.0;
+            for (int n = first + id; n < P; n += n_threads) steps += start[n + 1] - start[n];
+            busiest = std::max(busiest, steps);
+        }
+        critical_steps += busiest + (P - first) * n_coarse;
+
+        //correction série : U_{n+1} = G(U_n nouveau) + F(U_n ancien) - G(U_n ancien)
+        correction = 0.0;
+        for (int n = first; n < P; ++n) {
+            coarse_propagate(start, n, v_[backward_rows ? M_ - start[n] : start[n]], coarse_new, coarse_mid);
+            std::vector<double>& u = v_[backward_rows ? M_ - start[n + 1] : start[n + 1]];
+            for (int i = 0; i <= N_; ++i) {
+                double updated = coarse_new[i] + fine_end[n][i] - coarse_old[n][i];
+                correction = std::max(correction, std::abs(updated - u[i]));
+                u[i] = updated;
+            }
+            coarse_old[n].swap(coarse_new);
+        }
+        iterations++;
+        first++;
+        if (correction <= parareal_tol_) break;
+    }
+
+    for (int id = 0; id < n_threads; ++id) pool.release(stages[id]);
+    for (int n = 0; n < P; ++n) {
+        pool.release(fine_end[n]);
+        pool.release(coarse_old[n]);
+    }
+    pool.release(coarse_new);
+    pool.release(coarse_mid);
+
+    parareal_stats_.slices = P;
+    parareal_stats_.threads = n_threads;
+    parareal_stats_.iterations = iterations;
+    parareal_stats_.correction = correction;
+    parareal_stats_.model_speedup = M_ / critical_steps;
+    parareal_stats_.wall_ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - t0).count();
+}
+
+/**
+ * @brief Moyenne du payoff sur une maille, découpée aux points singuliers (quadrature de Gauss à 3 points)
+ * @param a Borne gauche de la maille
+ * @param b Borne droite de la maille
+ * @param log_space true si a et b sont des log-prix (x = ln S)
+ * @return Valeur moyenne du payoff sur [a, b]
+ */
+double Solver::cell_average(double a, double b, bool log_space) const {
+    const Option* option = edp_.getOption();
+    if (b <= a) return option->payoff(log_space ? std::exp(a) : a);
+
+    //découpage de la maille aux coudes/discontinuités du payoff : la quadrature est exacte par morceaux
+    std::vector<double> cuts(1, a);
+    std::vector<double> pts = option->singular_points();
+    std::sort(pts.begin(), pts.end());
+    for (std::size_t k = 0; k < pts.size(); ++k) {
+        if (pts[k] <= 0.0) continue;
+        double p = log_space ? std::log(pts[k]) : pts[k];
+        if (p > a && p < b) cuts.push_back(p);
+    }
+    cuts.push_back(b);
+
+    const double gx = std::sqrt(0.6); //noeuds de Gauss-Legendre à 3 points sur [-1, 1]
+    const double gw[3] = {5.0 / 9.0, 8.0 / 9.0, 5.0 / 9.0};
+    const double gp[3] = {-gx, 0.0, gx};
+    double sum = 0.0;
+    for (std::size_t k = 0; k + 1 < cuts.size(); ++k) {
+        double mid = 0.5 * (cuts[k] + cuts[k + 1]);
+        double half = 0.5 * (cuts[k + 1] - cuts[k]);
+        for (int q = 0; q < 3; ++q) {
+            double y = mid + half * gp[q];
+            sum += half * gw[q] * option->payoff(log_space ? std::exp(y) : y);
+        }
+    }
+    return sum / (b - a);
+}
+
+/**
+ * @brief Condition terminale au noeud i (ponctuelle ou moyennée sur la maille)
+ * @param i Indice du noeud dans S_
+ * @param log_space true si S_ contient des log-prix
+ * @return Valeur du payoff au noeud
+ */
+double Solver::terminal_value(int i, bool log_space) const {
+    if (!smoothing_) {
+        return edp_.getOption()->payoff(log_space ? std::exp(S_[i]) : S_[i]);
+    }
+    //maille centrée sur le noeud, tronquée au bord du domaine
+    double a = (i > 0) ? 0.5 * (S_[i - 1] + S_[i]) : S_[i];
+    double b = (i < N_) ? 0.5 * (S_[i] + S_[i + 1]) : S_[i];
+    return cell_average(a, b, log_space);
 }
 
 /**
@@ -47,31 +761,44 @@ std::vector< std::vector<double> > Solver::get_results() const {
  * @return Solution du système tridiagonal
  */
 std::vector<double> Solver::thomas_algorithm(const std::vector<double>& a, const std::vector<double>& b, const std::vector<double>& c, const std::vector<double>& d) {
+    std::vector<double> sol(d.size(), 0.0); //solution
+    thomas_solve(a, b, c, d, sol);
+    return sol;
+}
+
+/**
+ * @brief Algorithme de Thomas sans allocation (utilise les tampons cp_ et dp_)
+ * @param a Diagonale inférieure
+ * @param b Diagonale principale
+ * @param c Diagonale supérieure
+ * @param d Membre de droite
+ * @param sol Solution du système (doit avoir la taille de d)
+ */
+void Solver::thomas_solve(const std::vector<double>& a, const std::vector<double>& b, const std::vector<double>& c,
+                          const std::vector<double>& d, std::vector<double>& sol) {
     int n = d.size();  //taille du système
-    std::vector<double> cp(n, 0.0); //coefficients modifiés
-    std::vector<double> dp(n, 0.0); //membre de droite modifié
-    std::vector<double> sol(n, 0.0); //solution
+    if (static_cast<int>(cp_.size()) < n) cp_.resize(n); //coefficients modifiés
+    if (static_cast<int>(dp_.size()) < n) dp_.resize(n); //membre de droite modifié
 
     //Eliminer les coefficients a_i sous la diagonale pour transformer la matrice en une matrice triangulaire supérieure
-    cp[0] = c[0] / b[0];
-    dp[0] = d[0] / b[0]; 
+    cp_[0] = c[0] / b[0];
+    dp_[0] = d[0] / b[0]; 
 
     for (int i = 1; i < n; i++) {
-        double denom = b[i] - a[i] * cp[i - 1];  
+        double denom = b[i] - a[i] * cp_[i - 1];  
         if (std::abs(denom) < 1e-20) {
             denom = 1e-20;  
         }
-        cp[i] = c[i] / denom;
-        dp[i] = (d[i] - a[i] * dp[i - 1]) / denom;
+        cp_[i] = c[i] / denom;
+        dp_[i] = (d[i] - a[i] * dp_[i - 1]) / denom;
     }
 
     //La solution pour le dernier prix de l'action est simplement le dernier coefficient modifié 
-    sol[n - 1] = dp[n - 1];
+    sol[n - 1] = dp_[n - 1];
     // remonter la matrice triangulaire supérieure pour trouver les autres valeurs de la solution
     for (int i = n - 2; i >= 0; i--) {
-        sol[i] = dp[i] - cp[i] * sol[i + 1];
+        sol[i] = dp_[i] - cp_[i] * sol[i + 1];
     }
-    return sol;
 }
 
 
@@ -89,57 +816,222 @@ Cranck_nicolson::Cranck_nicolson(EDP& edp, int N, int M) :
  */
 
 void Cranck_nicolson::solve() {
-    double r = edp_.getR();  //on récupère le taux d'intérêt
-    double sigma = edp_.getSigma(); //on récupère la volatilité
-
-    //initialise la dernière ligne de la matrice v avec le payoff
+    //initialise la dernière ligne de la matrice v avec le payoff (éventuellement lissé)
     for (int i = 0; i <= N_; ++i) {
-        v_[M_][i] = edp_.getOption()->payoff(S_[i]);   //payoff de call ou put
+        v_[M_][i] = terminal_value(i, false);   //payoff de call ou put
     }
 
-    // Taille du système interne : N-1 points car on a 2 conditions aux bords
-    int n_size = N_ - 1;
-    std::vector<double> a(n_size), b(n_size), c(n_size), d(n_size);
+    //parcours le temps à l'envers : tau = T - t, la ligne j correspond à t_[j]
+    time_march(true);
+}
 
+/**
+ * @brief Opérateur de Black-Scholes discrétisé en S (différences centrées)
+ * @param r Taux sans risque
+ * @param sigma Volatilité
+ * @param op Opérateur rempli
+ */
+void Cranck_nicolson::fill_operator(double r, double sigma, Tridiagonal_operator& op) const {
+    for (int i = 1; i < N_; ++i) {  //pour chaque prix de l'actif
+        double s_i = S_[i];
+        double sigma2_s2 = sigma * sigma * s_i * s_i;
 
-    for (int j = M_ - 1; j >= 0; --j) { //parcours le temps à l'envers
-        for (int i = 1; i < N_; ++i) {  //pour chaque prix de l'actif
-            double s_i = S_[i];
-            double sigma2_s2 = sigma * sigma * s_i * s_i;
-            
-            //coefficients de crank-nicolson
-            double alpha = 0.25 * dt_ * (sigma2_s2 / (dS_ * dS_) - r * s_i / dS_);
-            double beta  = - 0.5 * dt_ * (sigma2_s2 / (dS_ * dS_) + r);
-            double gamma = 0.25 * dt_ * (sigma2_s2 / (dS_ * dS_) + r * s_i / dS_);
+        //V_tau = 0.5 sigma^2 S^2 V_SS + r S V_S - r V (Crank-Nicolson : alpha = 0.5 dt lower, etc.)
+        op.lower[i] = 0.5 * (sigma2_s2 / (dS_ * dS_) - r * s_i / dS_);
+        op.diag[i]  = - (sigma2_s2 / (dS_ * dS_) + r);
+        op.upper[i] = 0.5 * (sigma2_s2 / (dS_ * dS_) + r * s_i / dS_);
+    }
+}
 
-            // Matrice tridiagonale
-            a[i - 1] = -alpha;
-            b[i - 1] = 1.0 - beta;
-            c[i - 1] = -gamma;
+/**
+ * @brief Conditions aux bords de l'option au temps t = T - tau
+ * @param tau Temps avant maturité
+ * @param low Valeur en S=0
+ * @param high Valeur en S=L
+ */
+void Cranck_nicolson::boundary_values(double tau, double& low, double& high) const {
+    double t = edp_.getT() - tau;
+    low = edp_.getOption()->boundary_condition_low(0.0, t, edp_.discount_curve()); //condition à la frontière basse S=0
+    high = edp_.getOption()->boundary_condition_high(L_, t, edp_.discount_curve()); //condition à la frontière haute
+}
 
-            //membre de droite calculé à partir des prix à l'instant j+1
-            d[i - 1] = alpha * v_[j + 1][i - 1] + (1.0 + beta) * v_[j + 1][i] + gamma * v_[j + 1][i + 1];
-        }
+/**
+ * @brief Dérivées de l'opérateur de Black-Scholes par rapport à sigma et r
+ * @param d_sigma dA/dsigma
+ * @param d_r dA/dr
+ */
+void Cranck_nicolson::build_operator_derivatives(Tridiagonal_operator& d_sigma, Tridiagonal_operator& d_r) const {
+    double sigma = edp_.getSigma();
+    for (int i = 1; i < N_; ++i) {
+        double s_i = S_[i];
+        double ds2 = 2.0 * sigma * s_i * s_i / (dS_ * dS_); //d(sigma^2 S^2 / dS^2)/dsigma
+        d_sigma.lower[i] = 0.5 * ds2;
+        d_sigma.diag[i] = -ds2;
+        d_sigma.upper[i] = 0.5 * ds2;
+        d_r.lower[i] = -0.5 * s_i / dS_;
+        d_r.diag[i] = -1.0;
+        d_r.upper[i] = 0.5 * s_i / dS_;
+    }
+}
 
-        //conditions aux limites
-        v_[j][0] = edp_.getOption()->boundary_condition_low(edp_.getL(), t_[j]); //condition à la frontière basse
-        v_[j][N_] = edp_.getOption()->boundary_condition_high(edp_.getL(), t_[j]); //condition à la frontière haute
+/**
+ * @brief lambda . (D u) sur les noeuds intérieurs
+ */
+static double weighted_apply(const std::vector<double>& lambda, const Tridiagonal_operator& D, const std::vector<double>& u, int N) {
+    double s = 0.0;
+    for (int i = 1; i < N; ++i) s += lambda[i] * (D.lower[i] * u[i - 1] + D.diag[i] * u[i] + D.upper[i] * u[i + 1]);
+    return s;
+}
+
+/**
+ * @brief Adjoint d'un pas theta (I - theta h A) u_out = (I + (1-theta) h A) u_in
+ * @param u_in Solution au début du pas
+ * @param u_out Solution à la fin du pas
+ * @param theta Paramètre d'implicitation
+ * @param h Pas de temps
+ * @param mu Adjoint de u_out en entrée, adjoint de u_in en sortie (noeuds intérieurs)
+ * @param lambda Tampon pour le multiplicateur du pas
+ * @param d_sigma dA/dsigma
+ * @param d_r dA/dr
+ * @param g_sigma Gradient en sigma (accumulé)
+ * @param g_r Gradient en r (accumulé)
+ * @param b_in Gradients des valeurs de bord au début du pas (bas, haut ; accumulés)
+ * @param b_out Gradients des valeurs de bord à la fin du pas (bas, haut ; accumulés)
+ */
+void Cranck_nicolson::adjoint_step(const std::vector<double>& u_in, const std::vector<double>& u_out, double theta, double h,
+                                   std::vector<double>& mu, std::vector<double>& lambda,
+                                   const Tridiagonal_operator& d_sigma, const Tridiagonal_operator& d_r,
+                                   double& g_sigma, double& g_r, double b_in[2], double b_out[2]) {
+    //multiplicateur du pas : (I - theta h A)^T lambda = mu
+    stepper_.solve_shifted_transpose(theta * h, mu, lambda);
+
+    //dérivée du résidu par rapport aux paramètres, les bords compris dans u_in et u_out
+    g_sigma += h * (theta * weighted_apply(lambda, d_sigma, u_out, N_) + (1.0 - theta) * weighted_apply(lambda, d_sigma, u_in, N_));
+    g_r += h * (theta * weighted_apply(lambda, d_r, u_out, N_) + (1.0 - theta) * weighted_apply(lambda, d_r, u_in, N_));
+
+    //les valeurs de bord n'entrent que par les colonnes 0 et N de A
+    double low = lambda[1] * op_.lower[1];
+    double high = lambda[N_ - 1] * op_.upper[N_ - 1];
+    b_out[0] += theta * h * low;
+    b_out[1] += theta * h * high;
+    b_in[0] += (1.0 - theta) * h * low;
+    b_in[1] += (1.0 - theta) * h * high;
+
+    //adjoint de u_in : (I + (1-theta) h A)^T lambda
+    if (theta < 1.0) {
+        stepper_.apply_transpose(lambda, mu);
+        for (int i = 1; i < N_; ++i) mu[i] = lambda[i] + (1.0 - theta) * h * mu[i];
+    } else {
+        for (int i = 1; i < N_; ++i) mu[i] = lambda[i];
+    }
+}
+
+/**
+ * @brief Sensibilités du prix au spot S0 par la méthode adjointe, après solve()
+ * @param S0 Prix de l'actif
+ * @return Prix et sensibilités
+ * @throw std::invalid_argument pour BDF2, TR-BDF2 (schémas theta uniquement) ou avec une structure par terme
+ */
+Adjoint_sensitivities Cranck_nicolson::adjoint(double S0) {
+    Adjoint_sensitivities res;
+    adjoint(S0, res);
+    return res;
+}
+
+/**
+ * @brief Sensibilités par la méthode adjointe dans une structure existante (vecteurs réutilisés)
+ * @param S0 Prix de l'actif
+ * @param res Prix et sensibilités ; dlow et dhigh gardent leur mémoire d'un appel à l'autre
+ * @throw std::invalid_argument pour BDF2, TR-BDF2 (schémas theta uniquement) ou avec une structure par terme
+ */
+void Cranck_nicolson::adjoint(double S0, Adjoint_sensitivities& res) {
+    //en mode adaptatif Rannacher est remplacé par TR-BDF2
+    if (scheme_ == SCHEME_BDF2 || scheme_ == SCHEME_TR_BDF2 || (adaptive_tol_ > 0.0 && scheme_ == SCHEME_RANNACHER)) {
+        throw std::invalid_argument("Cranck_nicolson::adjoint : schémas theta uniquement (Crank-Nicolson, implicite, Rannacher)");
+    }
+    if (edp_.has_term_structure()) {
+        throw std::invalid_argument("Cranck_nicolson::adjoint : structure par terme non prise en charge");
+    }
+    const Option* option = edp_.getOption();
+    const Piecewise_curve* rate = edp_.discount_curve();
+    const double T = edp_.getT();
+
+    //la fonctionnelle est l'interpolation linéaire de la ligne t=0 au spot
+    double x = std::min(std::max(S0 / dS_, 0.0), static_cast<double>(N_));
+    int j = std::min(static_cast<int>(x), N_ - 1);
+    double w = x - j;
+
+    res.value = (1.0 - w) * v_[0][j] + w * v_[0][j + 1];
+    res.dsigma = 0.0;
+    res.dr = 0.0;
+    res.dlow.assign(M_ + 1, 0.0);
+    res.dhigh.assign(M_ + 1, 0.0);
+
+    Workspace_pool& pool = Workspace_pool::local();
+    std::vector<double> mu, lambda;
+    Tridiagonal_operator d_sigma, d_r;
+    pool.acquire(N_ + 1, mu);
+    pool.acquire(N_ + 1, lambda);
+    pool.acquire(N_ + 1, d_sigma.lower);
+    pool.acquire(N_ + 1, d_sigma.diag);
+    pool.acquire(N_ + 1, d_sigma.upper);
+    pool.acquire(N_ + 1, d_r.lower);
+    pool.acquire(N_ + 1, d_r.diag);
+    pool.acquire(N_ + 1, d_r.upper);
+
+    build_operator();
+    stepper_.set_operator(op_);
+    build_operator_derivatives(d_sigma, d_r);
 
-        //conditions aux limites dans le membre de droite
-        double s1 = S_[1];
-        double alpha1 = 0.25 * dt_ * (sigma * sigma * s1 * s1 / (dS_ * dS_) - r * s1 / dS_);
-        d[0] += alpha1 * v_[j][0]; //ajout de la condition à la frontière basse
+    std::fill(mu.begin(), mu.end(), 0.0);
+    if (j == 0) res.dlow[0] += 1.0 - w; else mu[j] = 1.0 - w;
+    if (j + 1 == N_) res.dhigh[0] += w; else mu[j + 1] = w;
 
-        double sN = S_[N_-1];
-        double gammaN = 0.25 * dt_ * (sigma * sigma * sN * sN / (dS_ * dS_) + r * sN / dS_);
-        d[n_size - 1] += gammaN * v_[j][N_]; //ajout de la condition à la frontière haute
+    //marche inverse : le pas k va de la ligne M-k+1 (tau_old) à la ligne M-k
+    for (int k = M_; k >= 1; --k) {
+        const std::vector<double>& u_old = v_[M_ - k + 1];
+        const std::vector<double>& u_new = v_[M_ - k];
+        double tau_old = T - t_[M_ - k + 1];
+        double dt = t_[M_ - k + 1] - t_[M_ - k];
+        double b_old[2] = {0.0, 0.0}, b_new[2] = {0.0, 0.0};
 
-        //résolution du système tridiagonal
-        std::vector<double> solution = thomas_algorithm(a, b, c, d);
-        for (int i = 1; i < N_; ++i) {
-            v_[j][i] = solution[i - 1];
+        double theta = (scheme_ == SCHEME_IMPLICIT) ? 1.0 : 0.5;
+        bool rannacher = scheme_ == SCHEME_RANNACHER && k <= rannacher_steps_;
+        if (rannacher || adaptive_tol_ > 0.0) {
+            //deux demi-pas (Rannacher : implicites ; adaptatif : la ligne acceptée est la solution en deux demi-pas)
+            //l'étape intermédiaire n'est pas stockée : on la recalcule
+            double theta_half = rannacher ? 1.0 : theta;
+            double tau_mid = tau_old + 0.5 * dt;
+            boundary_values(tau_mid, stage_[0], stage_[N_]);
+            stepper_.theta_step(u_old, stage_, 0.5 * dt, theta_half);
+            double b_mid[2] = {0.0, 0.0};
+            adjoint_step(stage_, u_new, theta_half, 0.5 * dt, mu, lambda, d_sigma, d_r, res.dsigma, res.dr, b_mid, b_new);
+            adjoint_step(u_old, stage_, theta_half, 0.5 * dt, mu, lambda, d_sigma, d_r, res.dsigma, res.dr, b_old, b_mid);
+            double t_mid = T - tau_mid;
+            res.dr += b_mid[0] * option->boundary_condition_low_dr(0.0, t_mid, rate) + b_mid[1] * option->boundary_condition_high_dr(L_, t_mid, rate);
+        } else {
+            adjoint_step(u_old, u_new, theta, dt, mu, lambda, d_sigma, d_r, res.dsigma, res.dr, b_old, b_new);
         }
+        res.dlow[M_ - k + 1] += b_old[0];
+        res.dhigh[M_ - k + 1] += b_old[1];
+        res.dlow[M_ - k] += b_new[0];
+        res.dhigh[M_ - k] += b_new[1];
     }
+
+    //rho des conditions aux bords ; la ligne M (maturité) porte le payoff, indépendant de r
+    for (int row = 0; row < M_; ++row) {
+        res.dr += res.dlow[row] * option->boundary_condition_low_dr(0.0, t_[row], rate)
+                + res.dhigh[row] * option->boundary_condition_high_dr(L_, t_[row], rate);
+    }
+
+    pool.release(mu);
+    pool.release(lambda);
+    pool.release(d_sigma.lower);
+    pool.release(d_sigma.diag);
+    pool.release(d_sigma.upper);
+    pool.release(d_r.lower);
+    pool.release(d_r.diag);
+    pool.release(d_r.upper);
 }
 
 /**
@@ -149,25 +1041,60 @@ void Cranck_nicolson::solve() {
  * @param M Nombre de points en temps
  */
 Implicite_solver::Implicite_solver(EDP& edp, int N, int M) : 
-    Solver(edp, N, M) {
+    Solver(edp, N, M), x_max_(0.0) {
         s_min=0.00001; //pour le changement de variable car ln(0) diverge
+        scheme_ = SCHEME_IMPLICIT;
     }
+/**
+ * @brief Bornes en S à t=0 de la grille réellement utilisée (alignement compris)
+ * @param s_low Borne basse exp(x_min - drift T)
+ * @param s_high Borne haute
+ */
+void Implicite_solver::domain_bounds(double& s_low, double& s_high) const {
+    double x_min, x_max, dx;
+    log_grid(x_min, x_max, dx);
+    s_low = std::exp(x_min - log_drift(edp_.getT()));
+    s_high = domain_high_;
+}
+
+/**
+ * @brief Grille en x = ln(S) + drift tau : bornes et pas, strike aligné si demandé
+ * @param x_min Borne basse (ln de la borne basse demandée à tau=0, déplacée par l'alignement)
+ * @param x_max Borne haute (ln de la borne haute demandée à t=0)
+ * @param dx Pas en x
+ */
+void Implicite_solver::log_grid(double& x_min, double& x_max, double& dx) const {
+    x_min = std::log(std::max(s_min, domain_low_));
+    x_max = std::log(domain_high_) + log_drift(edp_.getT());
+    dx = (x_max - x_min) / static_cast<double>(N_);
+
+    //alignement : à tau=0, le coude du payoff est en x = ln K ; on garde x_max et on ajuste le pas
+    double K = edp_.getOption()->getK();
+    if (alignment_ != ALIGN_NONE && K > std::exp(x_min)) {
+        double m = (x_max - std::log(K)) / dx;
+        if (m >= 1.0 && m < N_) {
+            double m_aligned = (alignment_ == ALIGN_NODE) ? std::floor(m + 0.5) : std::floor(m) + 0.5;
+            dx = (x_max - std::log(K)) / m_aligned;
+            x_min = x_max - N_ * dx;
+        }
+    }
+}
+
 /**
  * @brief Changement de variables S_ (prix)  pour l'EDP réduite 
  */
 void Implicite_solver::change_variable() {
-    double T = edp_.getT();
-    double r = edp_.getR();
-    double sigma2 = edp_.getSigma() * edp_.getSigma();
-    double drift = r - 0.5 * sigma2;
-    //changement de variable temporel
+    if (edp_.getOption()->upper_barrier() <= domain_high_) {
+        throw std::invalid_argument("Implicite_solver : barrière non prise en charge (frontière mobile en log-prix)");
+    }
+    //changement de variable temporel : t_ contient tau = T - t (tau=0 à maturité)
     for (int j=0; j<=M_; ++j){
-        t_[j]= T-j*dt_;
+        t_[j]= j*dt_;
     }
     //nouveau pas en espace
-    double x_min = std::log(s_min);
-    double x_max = std::log(edp_.getL()) + drift * T;
-    dS_ = (x_max - x_min) / static_cast<double>(N_);
+    double x_min, x_max;
+    log_grid(x_min, x_max, dS_);
+    x_max_ = x_max;
     //nouveau vecteur des prix (logarithmique)
     for (int i = 0; i <= N_; ++i) {
         S_[i] = x_min + i * dS_; // S_ stocke maintenant x = ln(S) 
@@ -177,76 +1104,164 @@ void Implicite_solver::change_variable() {
  * @brief Changement inverse des variables pour superposition des courbes
  */
 void Implicite_solver::reverse_variable() {
-    double r = edp_.getR();
     double T = edp_.getT();
-    double sigma2 = edp_.getSigma() * edp_.getSigma();
-    double drift = r - 0.5 * sigma2;
+    double drift_T = log_drift(T);
 
     for (int j = 0; j <= M_; ++j) {
         double tau = t_[j]; // t_ contient tau
+        //on repasse de u à V : un seul facteur e^{-r tau} par ligne (intégrale de r avec une structure par terme)
+        double discount = std::exp(-edp_.rate_integral(tau));
+        std::vector<double>& row = v_[j];
         for (int i = 0; i <= N_; ++i) {
-            //on repasse de u à V
-            v_[j][i] *= std::exp(-r * tau);
-            
-            //on ajuste S uniquement pour la sortie finale (souvent à j = M_, donc t=0)
-            if (j == M_) {
-                // Le x de calcul correspond au ln(S) + drift*T
-                // Donc S = exp(x - drift * T)
-                S_[i] = std::exp(S_[i] - drift * T);
-            }
+            row[i] *= discount;
         }
         //on remet le temps dans le bon sens
         t_[j] = T - tau; 
-        
     }
+
+    //on ajuste S pour la sortie finale (t=0) : le x de calcul correspond à ln(S) + drift*T, donc S = exp(x - drift * T)
+    for (int i = 0; i <= N_; ++i) {
+        S_[i] -= drift_T;
+    }
+    vector_exp(&S_[0], &S_[0], N_ + 1);
+    //comme pour Crank-Nicolson, l'indice 0 correspond à t=0 et l'indice M à la maturité
+    std::reverse(v_.begin(), v_.end());
+    std::reverse(t_.begin(), t_.end());
 }
 /** @brief Méthode de résolution de l'équation de Black-Scholes avec méthode implicite 
 */
 void Implicite_solver::solve() {
-    double r =edp_.getR();
-    double sigma2=edp_.getSigma() * edp_.getSigma();
     //changement de variables pour l'EDP réduite
     change_variable();
-    //pour l'EDP réduite (équation de la chaleur : u_t = 0.5 * sigma^2 * u_xx)
-    double lambda = (sigma2 * dt_) / (2.0 * dS_ * dS_);
-
-    double drift = r - 0.5 * sigma2;
-    double x_max = std::log(edp_.getL()) + drift * edp_.getT();
 
     //initialisation Payoff à l'instant t=0  et s=exp(s) car changement de variable 
-    for (int i = 0; i <= N_; ++i) {
-        v_[0][i] = edp_.getOption()->payoff(std::exp(S_[i]));
+    if (smoothing_) {
+        for (int i = 0; i <= N_; ++i) {
+            v_[0][i] = terminal_value(i, true);
+        }
+    } else {
+        //prix de tous les noeuds d'un coup, dans le tampon stage_ encore libre avant la marche
+        vector_exp(&S_[0], &stage_[0], N_ + 1);
+        const Option* option = edp_.getOption();
+        for (int i = 0; i <= N_; ++i) {
+            v_[0][i] = option->payoff(stage_[i]);
+        }
     }
-    
-    std::vector<double> a(N_ - 1, -lambda);  //diagonale inférieure
-    std::vector<double> b(N_ - 1, 1 + 2 * lambda); //diagonale principale
-    std::vector<double> c(N_ - 1, -lambda); //diagonale supérieure
-
-    for (int j = 1; j <= M_; ++j) {
 
-        std::vector<double> d(N_ - 1); //membre de droite
-
-        
-        double real_t_ = edp_.getT() - t_[j];
+    //marche en tau croissant : la ligne j correspond à tau = t_[j]
+    //les lignes de la marche sont en variable de la chaleur : le suivi n'est appelé qu'après le changement inverse
+    Progress_callback progress = progress_;
+    progress_ = nullptr;
+    time_march(false);
+    progress_ = progress;
+    reverse_variable();
+    notify_progress(0, M_ + 1);
+}
 
-        // Conditions aux bords après changement de variable (voir 2.4.2 du rapport)
-        v_[j][0] = edp_.getOption()->boundary_condition_low(x_max, real_t_) * std::exp(r * t_[j]); 
-        v_[j][N_] = edp_.getOption()->boundary_condition_high(x_max, real_t_) * std::exp(r * t_[j]);
+/**
+ * @brief Prix à t=0 de toute une gamme de maturités en une seule marche
+ * @param maturities Maturités dans ]0, T] (T de l'EDP : la plus longue)
+ * @param spots Prix de l'actif
+ * @return prices[m][k] : prix de maturité maturities[m] au spot spots[k]
+ * @throw std::invalid_argument pour une maturité hors de ]0, T], deux maturités sur le même noeud
+ *        (M trop petit), une structure par terme ou le pas adaptatif
+ */
+std::vector< std::vector<double> > Implicite_solver::solve_maturities(const std::vector<double>& maturities,
+                                                                      const std::vector<double>& spots) {
+    const double T = edp_.getT();
+    if (edp_.has_term_structure()) {
+        throw std::invalid_argument("Implicite_solver::solve_maturities : paramètres constants uniquement");
+    }
+    if (adaptive_tol_ > 0.0) {
+        throw std::invalid_argument("Implicite_solver::solve_maturities : incompatible avec le pas adaptatif");
+    }
+    for (std::size_t m = 0; m < maturities.size(); ++m) {
+        if (!(maturities[m] > 0.0 && maturities[m] <= T * (1.0 + 1e-12))) {
+            throw std::invalid_argument("Implicite_solver::solve_maturities : maturité hors de ]0, T]");
+        }
+    }
 
-        d[0] +=  lambda * v_[j][0]; //ajout de la condition à la frontière basse
-        d[N_-2] += lambda * v_[j][N_];  //ajout de la condition à la frontière haute
+    //une seule marche jusqu'à T, chaque maturité sur un noeud
+    node_tau_ = maturities;
+    try {
+        solve();
+    } catch (...) {
+        node_tau_.clear();
+        throw;
+    }
+    node_tau_.clear();
 
-        for (int i = 1; i < N_-2; ++i) {
-            d[i] = v_[j][i]; //membre de droite=prix à l'instant j
+    //après reverse_variable, la ligne j est au temps t_[j] = T - tau
+    const double x_min = x_max_ - N_ * dS_;
+    std::vector<double> log_spots(spots.size());
+    if (!spots.empty()) vector_log(&spots[0], &log_spots[0], spots.size());
+    std::vector< std::vector<double> > prices(maturities.size(), std::vector<double>(spots.size()));
+    for (std::size_t m = 0; m < maturities.size(); ++m) {
+        double tau = std::min(maturities[m], T);
+        int row = 0;
+        for (int j = 1; j <= M_; ++j) {
+            if (std::abs(t_[j] - (T - tau)) < std::abs(t_[row] - (T - tau))) row = j;
         }
 
-        //résolution du système tridiagonal
-        std::vector<double> sol = thomas_algorithm(a, b, c, d);
-        for (int i = 1; i < N_; ++i) {
-            v_[j][i] = sol[i - 1];
+        //x = ln S + dérive cumulée sur tau : même grille en x, prix S décalés selon la maturité
+        double drift_tau = log_drift(tau);
+        for (std::size_t k = 0; k < spots.size(); ++k) {
+            double x = (log_spots[k] + drift_tau - x_min) / dS_;
+            x = std::min(std::max(x, 0.0), static_cast<double>(N_));
+            int i = std::min(static_cast<int>(x), N_ - 1);
+            //interpolation linéaire en S, comme get_value_at_S
+            double s_inf = std::exp(x_min + i * dS_ - drift_tau);
+            double s_sup = std::exp(x_min + (i + 1) * dS_ - drift_tau);
+            double w = std::min(std::max((spots[k] - s_inf) / (s_sup - s_inf), 0.0), 1.0);
+            prices[m][k] = (1.0 - w) * v_[row][i] + w * v_[row][i + 1];
         }
     }
-    reverse_variable();
+    return prices;
+}
+
+/**
+ * @brief Opérateur de l'équation de la chaleur u_tau = 0.5 sigma^2 u_xx
+ * @param r Taux sans risque (absorbé par le changement de variable)
+ * @param sigma Volatilité
+ * @param op Opérateur rempli
+ */
+void Implicite_solver::fill_operator(double /*r*/, double sigma, Tridiagonal_operator& op) const {
+    double sigma2 = sigma * sigma;
+    double lambda = sigma2 / (2.0 * dS_ * dS_); //lambda * dt est le coefficient du schéma implicite
+    for (int i = 1; i < N_; ++i) {
+        op.lower[i] = lambda;
+        op.diag[i] = -2.0 * lambda;
+        op.upper[i] = lambda;
+    }
+}
+
+/**
+ * @brief Dérive cumulée de ln S sur les tau dernières années avant la maturité
+ * @param tau Temps avant maturité
+ * @return Intégrale de r - sigma^2/2 sur [T - tau, T]
+ */
+double Implicite_solver::log_drift(double tau) const {
+    if (edp_.has_term_structure()) return edp_.rate_integral(tau) - 0.5 * edp_.variance_integral(tau);
+    return (edp_.getR() - 0.5 * edp_.getSigma() * edp_.getSigma()) * tau;
+}
+
+/**
+ * @brief Conditions aux bords après changement de variable (u = e^{r tau} V)
+ * @param tau Temps avant maturité
+ * @param low Valeur en x_min
+ * @param high Valeur en x_max
+ */
+void Implicite_solver::boundary_values(double tau, double& low, double& high) const {
+    double real_t = edp_.getT() - tau;
+    double growth = std::exp(edp_.rate_integral(tau)); // e^{r tau}, ou exp de l'intégrale de r
+
+    // Conditions aux bords après changement de variable (voir 2.4.2 du rapport)
+    // les frontières x_min et x_max correspondent aux prix S = exp(x - drift * tau) : le bord bas est en s_low > 0
+    double drift = log_drift(tau);
+    double s_low = std::exp(S_[0] - drift);
+    double s_high = std::exp(x_max_ - drift);
+    low = edp_.getOption()->boundary_condition_low(s_low, real_t, edp_.discount_curve()) * growth;
+    high = edp_.getOption()->boundary_condition_high(s_high, real_t, edp_.discount_curve()) * growth;
 }
 
 /**
@@ -9,9 +9,55 @@
 #define SOLVER_HPP
 
 #include "edp.hpp"
+#include "domain.hpp"
+#include "time_stepping.hpp"
 #include <vector>
 
 
+/**
+ * @brief Placement du strike sur la grille en espace
+ */
+enum Grid_alignment {
+    ALIGN_NONE,     // grille uniforme sur [0, L] sans ajustement
+    ALIGN_NODE,     // le strike tombe exactement sur un noeud
+    ALIGN_MIDPOINT  // le strike tombe au milieu d'une maille
+};
+
+
+/**
+ * @brief Fonction appelée pendant solve() quand des lignes de la matrice des solutions sont prêtes
+ * @param user Pointeur transmis tel quel
+ * @param row_begin Première ligne prête
+ * @param row_end Ligne suivant la dernière ligne prête
+ */
+typedef void (*Progress_callback)(void* user, int row_begin, int row_end);
+
+
+/**
+ * @brief Bilan du dernier solve() en mode parareal
+ */
+struct Parareal_stats {
+    int slices;           // nombre de tranches en temps
+    int threads;          // nombre de threads des propagateurs fins
+    int iterations;       // itérations effectuées
+    double correction;    // dernière correction (norme max aux bords des tranches)
+    double model_speedup; // pas fins du solve série / pas du chemin critique (fins et grossiers)
+    double wall_ms;       // durée de la marche parareal
+};
+
+
+/**
+ * @brief Sensibilités obtenues par une passe adjointe (marche en temps inverse)
+ */
+struct Adjoint_sensitivities {
+    double value;              // prix au spot demandé (interpolation linéaire de la ligne t=0)
+    double dsigma;             // dV/dsigma (vega)
+    double dr;                 // dV/dr (rho), conditions aux bords comprises
+    std::vector<double> dlow;  // dV/d(valeur imposée au bord bas) à chaque ligne de la matrice des solutions
+    std::vector<double> dhigh; // dV/d(valeur imposée au bord haut) à chaque ligne de la matrice des solutions
+};
+
+
 /**
  * @brief Classe abstraite Solver
  */
@@ -20,13 +66,198 @@ class Solver {
 protected:
     EDP& edp_;   // Référence vers l'EDP à résoudre
     int N_;      // Nombre de points en espace
-    int M_;      // Nombre de points en temps
+    int M_;      // Nombre de points en temps (lignes de la dernière marche, adaptative ou non)
+    int M_config_; // Nombre de pas de temps demandé : chaque marche repart de T/M_config_
     double dt_;  // Pas de temps
     double dS_;  // Pas en espace
+    double L_;   // Borne haute effective du domaine (ajustée par l'alignement ou la barrière)
+    double domain_low_;   // Borne basse demandée du domaine (0 par défaut)
+    double domain_high_;  // Borne haute demandée du domaine (L de l'EDP par défaut)
+    bool smoothing_;            // Condition terminale moyennée sur les mailles
+    Grid_alignment alignment_;  // Placement du strike sur la grille
     std::vector<double> S_;     // vecteur des prix de l'actif
     std::vector<double> t_;     // vecteur des temps
     std::vector< std::vector<double> > v_; // Matrice des solutions (valeurs de l'option) 
 
+    Time_scheme scheme_;        // Schéma en temps
+    int rannacher_steps_;       // Nombre de pas Crank-Nicolson remplacés par deux demi-pas implicites
+    double adaptive_tol_;       // Tolérance d'erreur locale du pas adaptatif (0 : pas fixe T/M)
+    int rejected_steps_;        // Pas rejetés par le contrôleur adaptatif
+    int parareal_slices_;       // Nombre de tranches parareal (0 ou 1 : marche série)
+    int parareal_threads_;      // Threads des propagateurs fins (0 : nombre de coeurs)
+    int parareal_coarse_steps_; // Pas d'Euler implicite du propagateur grossier par tranche
+    double parareal_tol_;       // Tolérance sur la correction aux bords des tranches
+    Parareal_stats parareal_stats_; // Bilan du dernier solve() parareal
+    Progress_callback progress_;    // Suivi de la marche en temps (nullptr : aucun)
+    void* progress_user_;           // Pointeur transmis au suivi
+    int progress_every_;            // Nombre de pas entre deux appels du suivi
+    Tridiagonal_operator op_;   // Opérateur spatial de la semi-discrétisation du/dtau = A u
+    std::vector<Tridiagonal_operator> piece_ops_; // Opérateurs par morceau de la structure par terme (vide : op_ partout)
+    std::vector<double> piece_tau_;               // Début de chaque morceau en tau, croissant
+    std::vector<double> march_tau_;               // Temps des lignes de la marche uniforme (vide sans structure par terme)
+    std::vector<double> node_tau_;                // Temps avant maturité à placer exactement sur des noeuds (maturités)
+    Time_stepper stepper_;      // Schémas en temps partagés par les solveurs
+
+    // tampons de calcul empruntés au pool de travail du thread
+    std::vector<double> stage_;   // étape intermédiaire (demi-pas, TR-BDF2), taille N+1
+    std::vector<double> cp_, dp_; // coefficients modifiés de l'algorithme de Thomas
+
+    /**
+     * @brief Remplit un opérateur spatial du solveur pour des paramètres constants
+     * @param r Taux sans risque
+     * @param sigma Volatilité
+     * @param op Opérateur rempli (noeuds intérieurs)
+     */
+    virtual void fill_operator(double r, double sigma, Tridiagonal_operator& op) const = 0;
+
+    /**
+     * @brief Remplit op_ avec les constantes de l'EDP et, avec une structure par terme, un opérateur par morceau
+     */
+    void build_operator();
+
+    /**
+     * @brief Opérateur en vigueur au temps avant maturité tau
+     * @param tau Temps avant maturité
+     * @return Opérateur du morceau contenant tau (op_ sans structure par terme)
+     */
+    const Tridiagonal_operator& operator_at(double tau) const;
+
+    /**
+     * @brief Donne au pas de temps l'opérateur en vigueur en tau ; ses factorisations ne sont
+     * recalculées qu'au changement de morceau
+     * @param stepper Pas de temps
+     * @param tau Temps avant maturité (milieu du pas)
+     */
+    void select_operator(Time_stepper& stepper, double tau) const;
+
+    /**
+     * @brief Temps avant maturité des lignes de la marche, chaque date de changement de la structure
+     * par terme et chaque temps de node_tau_ étant déplacé sur le noeud le plus proche
+     * @param taus Vecteur des M+1 temps, croissants
+     * @throw std::invalid_argument si deux temps de node_tau_ tombent sur le même noeud
+     */
+    void march_times(std::vector<double>& taus) const;
+
+    /**
+     * @brief Valeurs de Dirichlet aux deux bords, dans l'inconnue du solveur
+     * @param tau Temps avant maturité
+     * @param low Valeur au premier noeud
+     * @param high Valeur au dernier noeud
+     */
+    virtual void boundary_values(double tau, double& low, double& high) const = 0;
+
+    /**
+     * @brief Avance d'un pas avec un schéma à un pas
+     * @param u_old Solution au temps tau_old
+     * @param u_new Solution au temps tau_old + dt (les bords sont fixés ici)
+     * @param tau_old Temps avant maturité au début du pas
+     * @param dt Pas de temps
+     * @param scheme SCHEME_CRANK_NICOLSON, SCHEME_IMPLICIT, SCHEME_TR_BDF2, ou SCHEME_RANNACHER pour deux demi-pas implicites
+     */
+    void one_step(const std::vector<double>& u_old, std::vector<double>& u_new, double tau_old, double dt, Time_scheme scheme);
+
+    /**
+     * @brief Même pas que one_step avec un pas de temps et une étape fournis (sûr entre threads)
+     * @param stepper Pas de temps utilisé (un par thread)
+     * @param stage Étape intermédiaire de taille N+1 (un par thread)
+     * @param u_old Solution au temps tau_old
+     * @param u_new Solution au temps tau_old + dt (les bords sont fixés ici)
+     * @param tau_old Temps avant maturité au début du pas
+     * @param dt Pas de temps
+     * @param scheme SCHEME_CRANK_NICOLSON, SCHEME_IMPLICIT, SCHEME_TR_BDF2, ou SCHEME_RANNACHER pour deux demi-pas implicites
+     */
+    void one_step(Time_stepper& stepper, std::vector<double>& stage, const std::vector<double>& u_old, std::vector<double>& u_new,
+                  double tau_old, double dt, Time_scheme scheme) const;
+
+    /**
+     * @brief Marche adaptative : chaque pas est comparé à deux demi-pas, le pas grandit ou diminue selon l'erreur
+     * @param backward_rows même convention de stockage que time_march
+     */
+    void adaptive_march(bool backward_rows);
+
+    /**
+     * @brief Remet la grille en temps uniforme de M_config_ pas après une marche adaptative, condition initiale conservée
+     * @param backward_rows même convention de stockage que time_march
+     */
+    void restore_time_grid(bool backward_rows);
+
+    /**
+     * @brief Marche parareal : propagateur grossier série (Euler implicite à grands pas),
+     * propagateurs fins concurrents sur les tranches, corrigés jusqu'à la tolérance
+     * @param backward_rows même convention de stockage que time_march
+     */
+    void parareal_march(bool backward_rows);
+
+    /**
+     * @brief Propagateur grossier de parareal : pas d'Euler implicite sur une tranche
+     * @param start Premier pas fin de chaque tranche
+     * @param n Indice de la tranche
+     * @param u_start Solution au début de la tranche
+     * @param u_end Solution à la fin de la tranche
+     * @param mid Tampon pour les pas intermédiaires
+     */
+    void coarse_propagate(const std::vector<int>& start, int n, const std::vector<double>& u_start,
+                          std::vector<double>& u_end, std::vector<double>& mid);
+
+    /**
+     * @brief Marche en tau de 0 à T avec le schéma choisi, la condition initiale étant déjà en place
+     * @param backward_rows true si tau = k dt est stocké à la ligne M-k (temps calendaire), false pour la ligne k
+     */
+    void time_march(bool backward_rows);
+
+    /**
+     * @brief Recopie dans t_ les temps de la marche quand des noeuds ont été déplacés sur les dates de changement
+     * @param backward_rows même convention de stockage que time_march
+     */
+    void store_march_times(bool backward_rows);
+
+    /**
+     * @brief Appelle le suivi de la marche s'il est défini
+     * @param row_begin Première ligne prête
+     * @param row_end Ligne suivant la dernière ligne prête
+     */
+    void notify_progress(int row_begin, int row_end);
+
+    /**
+     * @brief Algorithme de Thomas sans allocation (utilise les tampons cp_ et dp_)
+     * @param a Diagonale inférieure
+     * @param b Diagonale principale
+     * @param c Diagonale supérieure
+     * @param d Membre de droite
+     * @param sol Solution du système (doit avoir la taille de d)
+     */
+    void thomas_solve(const std::vector<double>& a, const std::vector<double>& b, const std::vector<double>& c,
+                      const std::vector<double>& d, std::vector<double>& sol);
+
+    /**
+     * @brief Construit la grille uniforme en S sur [0, L_] selon l'alignement demandé
+     */
+    void build_grid();
+
+    /**
+     * @brief Bornes en S réellement utilisées par le solveur (là où les conditions de Dirichlet s'appliquent à t=0)
+     * @param s_low Borne basse (0 : pas de bord bas)
+     * @param s_high Borne haute
+     */
+    virtual void domain_bounds(double& s_low, double& s_high) const;
+
+    /**
+     * @brief Moyenne du payoff sur une maille, découpée aux points singuliers (quadrature de Gauss à 3 points)
+     * @param a Borne gauche de la maille
+     * @param b Borne droite de la maille
+     * @param log_space true si a et b sont des log-prix (x = ln S)
+     * @return Valeur moyenne du payoff sur [a, b]
+     */
+    double cell_average(double a, double b, bool log_space) const;
+
+    /**
+     * @brief Condition terminale au noeud i (ponctuelle ou moyennée sur la maille)
+     * @param i Indice du noeud dans S_
+     * @param log_space true si S_ contient des log-prix
+     * @return Valeur du payoff au noeud
+     */
+    double terminal_value(int i, bool log_space) const;
+
 public:
     /**
      * @brief Constructeur de la classe Solver
@@ -35,6 +266,104 @@ public:
      * @param M Nombre de points en temps
      */
     Solver(EDP& edp, int N, int M);   
+
+    /**
+     * @brief Destructeur virtuel de la classe Solver (rend la mémoire au pool du thread)
+     */
+    virtual ~Solver();
+
+    /**
+     * @brief Active le lissage du payoff (moyenne sur chaque maille au lieu de la valeur au noeud)
+     * @param on true pour activer
+     */
+    void set_payoff_smoothing(bool on);
+
+    /**
+     * @brief Choisit le placement du strike sur la grille
+     * @param alignment ALIGN_NONE, ALIGN_NODE ou ALIGN_MIDPOINT
+     */
+    void set_grid_alignment(Grid_alignment alignment);
+
+    /**
+     * @brief Getter pour la grille en espace
+     * @return Vecteur des prix de l'actif aux noeuds
+     */
+    std::vector<double> get_grid() const;
+
+    /**
+     * @brief Fixe le domaine de calcul à la place du L de l'EDP
+     * @param s_low Borne basse (ignorée par Crank-Nicolson dont la grille part de 0)
+     * @param s_high Borne haute
+     */
+    void set_domain(double s_low, double s_high);
+
+    /**
+     * @brief Choisit le domaine à n_std écarts-types en log-prix autour des spots et du strike
+     * @param spots Prix de l'actif où l'on veut le prix
+     * @param n_std Nombre d'écarts-types sigma sqrt(T) de chaque côté
+     * @return Domaine choisi, avec l'erreur de bord estimée pour ce solveur
+     */
+    Domain set_auto_domain(const std::vector<double>& spots, double n_std = 5.0);
+
+    /**
+     * @brief Erreur estimée sur les prix aux spots due aux conditions aux bords du domaine courant
+     * @param spots Prix de l'actif où l'on veut le prix
+     * @return Borne P(toucher le bord) x (écart de la condition au bord)
+     */
+    double boundary_error(const std::vector<double>& spots) const;
+
+    /**
+     * @brief Choisit le schéma en temps
+     * @param scheme SCHEME_CRANK_NICOLSON, SCHEME_IMPLICIT, SCHEME_RANNACHER, SCHEME_BDF2 ou SCHEME_TR_BDF2
+     * @param rannacher_steps Nombre de pas de démarrage implicites (Rannacher)
+     */
+    void set_time_scheme(Time_scheme scheme, int rannacher_steps = 2);
+
+    /**
+     * @brief Active le pas de temps adaptatif (estimation de l'erreur locale par doublement de pas)
+     *
+     * M sert alors de pas initial T/M ; la grille en temps choisie est conservée dans t_ et
+     * le nombre de lignes de la matrice des solutions s'adapte. Chaque solve() repart du M demandé :
+     * deux résolutions successives donnent la même grille. BDF2 et Rannacher sont remplacés par TR-BDF2.
+     * @param tolerance Erreur locale maximale tolérée par pas (norme max), 0 pour revenir au pas fixe
+     */
+    void set_adaptive(double tolerance);
+
+    /**
+     * @brief Active le mode parareal (parallèle en temps) pour les marches longues
+     *
+     * Les M pas sont découpés en tranches ; le schéma choisi sert de propagateur fin sur chaque tranche
+     * (BDF2 est remplacé par TR-BDF2). Le pas adaptatif, s'il est actif, est prioritaire.
+     * @param n_slices Nombre de tranches en temps (0 ou 1 pour revenir à la marche série)
+     * @param tolerance Correction maximale aux bords des tranches pour arrêter les itérations
+     * @param n_threads Nombre de threads (0 : nombre de coeurs)
+     * @param coarse_steps Pas d'Euler implicite du propagateur grossier par tranche
+     */
+    void set_parareal(int n_slices, double tolerance = 1e-6, int n_threads = 0, int coarse_steps = 2);
+
+    /**
+     * @brief Getter pour le bilan du dernier solve() en mode parareal
+     * @return Itérations, correction finale et accélération du modèle de travail
+     */
+    Parareal_stats get_parareal_stats() const;
+
+    /**
+     * @brief Getter pour la grille en temps (non uniforme en mode adaptatif)
+     * @return Vecteur des temps associés aux lignes de la matrice des solutions
+     */
+    std::vector<double> get_times() const;
+
+    /**
+     * @brief Getter pour le nombre de pas rejetés par le contrôleur adaptatif
+     * @return Nombre de pas rejetés lors du dernier solve()
+     */
+    int get_rejected_steps() const;
+
+    /**
+     * @brief Getter pour le schéma en temps
+     * @return Schéma utilisé par solve()
+     */
+    Time_scheme get_time_scheme() const;
     
 
     /**
@@ -48,6 +377,22 @@ public:
      */
     std::vector< std::vector<double> > get_results() const;
     
+    /**
+     * @brief Accès sans copie à la matrice des solutions (lisible pendant solve() depuis le suivi)
+     * @return Référence vers la matrice des solutions
+     */
+    const std::vector< std::vector<double> >& get_surface() const;
+
+    /**
+     * @brief Définit une fonction appelée pendant la marche en temps quand des lignes sont prêtes
+     *
+     * En mode adaptatif ou parareal, un seul appel a lieu en fin de marche.
+     * @param callback Fonction de suivi (nullptr pour désactiver)
+     * @param user Pointeur transmis à la fonction
+     * @param every Nombre de pas entre deux appels
+     */
+    void set_progress_callback(Progress_callback callback, void* user, int every = 16);
+
     /**
      * @brief Algorithme de Thomas pour résoudre un système tridiagonal
      * @param a Diagonale inférieure
@@ -76,9 +421,77 @@ public:
     Cranck_nicolson(EDP& edp, int N, int M);  
 
     /**
-     * @brief Méthode de résolution crank-nicolson
+     * @brief Méthode de résolution crank-nicolson (ou du schéma choisi par set_time_scheme)
      */
     void solve() ;
+
+    /**
+     * @brief Sensibilités du prix au spot S0 par la méthode adjointe, après solve()
+     *
+     * Une seule marche inverse à travers les systèmes tridiagonaux transposés donne vega, rho et la
+     * sensibilité à chaque valeur de bord, pour environ deux à trois fois le coût de solve().
+     * En mode adaptatif, chaque ligne acceptée est rejouée en deux demi-pas comme dans la marche directe
+     * (dérivée à grille en temps fixée).
+     * @param S0 Prix de l'actif
+     * @return Prix et sensibilités
+     * @throw std::invalid_argument pour BDF2, TR-BDF2 (schémas theta uniquement) ou avec une structure par terme
+     */
+    Adjoint_sensitivities adjoint(double S0);
+
+    /**
+     * @brief Sensibilités par la méthode adjointe dans une structure existante (vecteurs réutilisés)
+     *
+     * Même calcul que adjoint(S0) ; les vecteurs dlow et dhigh gardent leur mémoire d'un appel à l'autre,
+     * ce qui évite toute allocation dans une boucle de portefeuille.
+     * @param S0 Prix de l'actif
+     * @param res Prix et sensibilités
+     * @throw std::invalid_argument pour BDF2, TR-BDF2 (schémas theta uniquement) ou avec une structure par terme
+     */
+    void adjoint(double S0, Adjoint_sensitivities& res);
+
+protected:
+    /**
+     * @brief Dérivées de l'opérateur de Black-Scholes par rapport à sigma et r
+     * @param d_sigma dA/dsigma
+     * @param d_r dA/dr
+     */
+    void build_operator_derivatives(Tridiagonal_operator& d_sigma, Tridiagonal_operator& d_r) const;
+
+    /**
+     * @brief Adjoint d'un pas theta (I - theta h A) u_out = (I + (1-theta) h A) u_in
+     * @param u_in Solution au début du pas
+     * @param u_out Solution à la fin du pas
+     * @param theta Paramètre d'implicitation
+     * @param h Pas de temps
+     * @param mu Adjoint de u_out en entrée, adjoint de u_in en sortie (noeuds intérieurs)
+     * @param lambda Tampon pour le multiplicateur du pas
+     * @param d_sigma dA/dsigma
+     * @param d_r dA/dr
+     * @param g_sigma Gradient en sigma (accumulé)
+     * @param g_r Gradient en r (accumulé)
+     * @param b_in Gradients des valeurs de bord au début du pas (bas, haut ; accumulés)
+     * @param b_out Gradients des valeurs de bord à la fin du pas (bas, haut ; accumulés)
+     */
+    void adjoint_step(const std::vector<double>& u_in, const std::vector<double>& u_out, double theta, double h,
+                      std::vector<double>& mu, std::vector<double>& lambda,
+                      const Tridiagonal_operator& d_sigma, const Tridiagonal_operator& d_r,
+                      double& g_sigma, double& g_r, double b_in[2], double b_out[2]);
+
+    /**
+     * @brief Opérateur de Black-Scholes discrétisé en S (différences centrées)
+     * @param r Taux sans risque
+     * @param sigma Volatilité
+     * @param op Opérateur rempli
+     */
+    void fill_operator(double r, double sigma, Tridiagonal_operator& op) const;
+
+    /**
+     * @brief Conditions aux bords de l'option au temps t = T - tau
+     * @param tau Temps avant maturité
+     * @param low Valeur en S=0
+     * @param high Valeur en S=L
+     */
+    void boundary_values(double tau, double& low, double& high) const;
 };
 
 
@@ -90,6 +503,45 @@ public:
 class Implicite_solver : public Solver {  
 protected:
     double s_min; //valeur minimale pour changement de variable car ln(0) diverge
+    double x_max_; //borne haute en x = ln(S) + drift * tau
+
+    /**
+     * @brief Opérateur de l'équation de la chaleur u_tau = 0.5 sigma^2 u_xx
+     * @param r Taux sans risque (absorbé par le changement de variable)
+     * @param sigma Volatilité
+     * @param op Opérateur rempli
+     */
+    void fill_operator(double r, double sigma, Tridiagonal_operator& op) const;
+
+    /**
+     * @brief Dérive cumulée de ln S sur les tau dernières années avant la maturité
+     * @param tau Temps avant maturité
+     * @return Intégrale de r - sigma^2/2 sur [T - tau, T]
+     */
+    double log_drift(double tau) const;
+
+    /**
+     * @brief Conditions aux bords après changement de variable (u = e^{r tau} V)
+     * @param tau Temps avant maturité
+     * @param low Valeur en x_min
+     * @param high Valeur en x_max
+     */
+    void boundary_values(double tau, double& low, double& high) const;
+
+    /**
+     * @brief Bornes en S à t=0 de la grille réellement utilisée (alignement compris)
+     * @param s_low Borne basse exp(x_min - drift T)
+     * @param s_high Borne haute
+     */
+    void domain_bounds(double& s_low, double& s_high) const;
+
+    /**
+     * @brief Grille en x = ln(S) + drift tau : bornes et pas, strike aligné si demandé
+     * @param x_min Borne basse (ln de la borne basse demandée à tau=0, déplacée par l'alignement)
+     * @param x_max Borne haute (ln de la borne haute demandée à t=0)
+     * @param dx Pas en x
+     */
+    void log_grid(double& x_min, double& x_max, double& dx) const;
 public:
     /**
      * @brief Constructeur de la classe Implicite_solver
@@ -102,6 +554,7 @@ public:
     /**
      * @brief Changement des variables 
      * S_ (prix) et t_ (temps) pour l'EDP réduite 
+     * @throw std::invalid_argument pour une option à barrière (frontière mobile en log-prix)
      */
     void change_variable();
 
@@ -111,10 +564,25 @@ public:
     void reverse_variable();
     
     /**
-     * @brief Méthode de résolution implicite
+     * @brief Méthode de résolution implicite (ou du schéma choisi par set_time_scheme)
      */
     void solve() ;
 
+    /**
+     * @brief Prix à t=0 de toute une gamme de maturités en une seule marche
+     *
+     * Avec des paramètres constants, la ligne tau de la marche vers la maturité T de l'EDP est le prix
+     * à t=0 de l'option de maturité tau (les conditions aux bords de l'option ne dépendent que de T - t,
+     * chaque ligne porte donc celles de sa maturité) : chaque maturité est placée exactement sur un
+     * noeud en temps et lue sur sa ligne, avec la dérive propre à tau pour repasser de x à S.
+     * @param maturities Maturités dans ]0, T] (T de l'EDP : la plus longue)
+     * @param spots Prix de l'actif
+     * @return prices[m][k] : prix de maturité maturities[m] au spot spots[k]
+     * @throw std::invalid_argument pour une maturité hors de ]0, T], deux maturités sur le même noeud
+     *        (M trop petit), une structure par terme ou le pas adaptatif
+     */
+    std::vector< std::vector<double> > solve_maturities(const std::vector<double>& maturities, const std::vector<double>& spots);
+
  /**
  * @brief Récupère la valeur de l'option pour un prix S précis par interpolation
  * @param s_target Le prix S que l'on cherche (ex: 100.0)
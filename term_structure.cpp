@@ -0,0 +1,105 @@
+/**
+ * @file term_structure.cpp
+ * @author Mathias LE BOUEDEC - Lilou MALFOY
+ * @date 2025
+ * @brief Implémentation de la courbe constante par morceaux
+ */
+
+#include "term_structure.hpp"
+#include <algorithm>
+#include <stdexcept>
+
+
+/**
+ * @brief Courbe constante
+ * @param value Valeur
+ */
+Piecewise_curve::Piecewise_curve(double value) : first_(value) {}
+
+/**
+ * @brief Courbe constante par morceaux
+ * @param times Dates de changement de valeur, strictement croissantes
+ * @param values Valeurs sur chaque morceau (une de plus que de dates)
+ * @throw std::invalid_argument si les tailles ne correspondent pas ou si les dates ne sont pas croissantes
+ */
+Piecewise_curve::Piecewise_curve(const std::vector<double>& times, const std::vector<double>& values)
+    : first_(values.empty() ? 0.0 : values[0]), times_(times) {
+    if (values.size() != times_.size() + 1) {
+        throw std::invalid_argument("Piecewise_curve : il faut une valeur de plus que de dates");
+    }
+    values_.assign(values.begin() + 1, values.end());
+    for (std::size_t k = 1; k < times_.size(); ++k) {
+        if (!(times_[k] > times_[k - 1])) throw std::invalid_argument("Piecewise_curve : dates non croissantes");
+    }
+}
+
+/**
+ * @brief Valeur de la courbe
+ * @param t Temps calendaire
+ * @return Valeur sur le morceau contenant t
+ */
+double Piecewise_curve::value(double t) const {
+    if (times_.empty()) return first_;
+    return piece(std::upper_bound(times_.begin(), times_.end(), t) - times_.begin());
+}
+
+/**
+ * @brief Intégrale de la courbe
+ * @param t0 Début
+ * @param t1 Fin (t1 >= t0)
+ * @return Intégrale sur [t0, t1]
+ */
+double Piecewise_curve::integral(double t0, double t1) const {
+    if (times_.empty()) return first_ * (t1 - t0);
+    std::size_t k = std::upper_bound(times_.begin(), times_.end(), t0) - times_.begin();
+    double sum = 0.0, t = t0;
+    for (; k < times_.size() && times_[k] < t1; ++k) {
+        sum += piece(k) * (times_[k] - t);
+        t = times_[k];
+    }
+    return sum + piece(k) * (t1 - t);
+}
+
+/**
+ * @brief Intégrale du carré de la courbe (variance cumulée pour une volatilité)
+ * @param t0 Début
+ * @param t1 Fin (t1 >= t0)
+ * @return Intégrale du carré sur [t0, t1]
+ */
+double Piecewise_curve::integral_squared(double t0, double t1) const {
+    if (times_.empty()) return first_ * first_ * (t1 - t0);
+    std::size_t k = std::upper_bound(times_.begin(), times_.end(), t0) - times_.begin();
+    double sum = 0.0, t = t0;
+    for (; k < times_.size() && times_[k] < t1; ++k) {
+        double v = piece(k);
+        sum += v * v * (times_[k] - t);
+        t = times_[k];
+    }
+    double v = piece(k);
+    return sum + v * v * (t1 - t);
+}
+
+/**
+ * @brief Valeur sur un morceau
+ * @param k Indice du morceau (0 : avant la première date)
+ * @return Valeur
+ */
+double Piecewise_curve::piece(std::size_t k) const {
+    return k == 0 ? first_ : values_[k - 1];
+}
+
+/**
+ * @brief Getter pour les dates de changement de valeur
+ * @return Dates croissantes
+ */
+const std::vector<double>& Piecewise_curve::times() const {
+    return times_;
+}
+
+/**
+ * @brief Indique si la courbe est constante
+ * @return true si la courbe n'a qu'un morceau
+ */
+bool Piecewise_curve::is_flat() const {
+    return times_.empty();
+}
@@ -0,0 +1,85 @@
+/**
+ * @file term_structure.hpp
+ * @author Mathias LE BOUEDEC - Lilou MALFOY
+ * @date 2025
+ * @brief Courbe constante par morceaux en temps (structure par terme du taux ou de la volatilité)
+ */
+
+#ifndef TERM_STRUCTURE_HPP
+#define TERM_STRUCTURE_HPP
+
+#include <vector>
+
+
+/**
+ * @brief Fonction du temps calendaire constante par morceaux
+ *
+ * Avec les dates de changement b_0 < b_1 < ... < b_{n-1} et les valeurs v_0, ..., v_n,
+ * la courbe vaut v_0 avant b_0, v_k sur [b_{k-1}, b_k) et v_n après b_{n-1}.
+ */
+class Piecewise_curve {
+private:
+    double first_;               // valeur avant la première date (seule valeur d'une courbe constante)
+    std::vector<double> times_;  // dates de changement de valeur, croissantes
+    std::vector<double> values_; // valeur après chaque date (times_.size()) : une courbe constante n'alloue rien
+
+    /**
+     * @brief Valeur sur un morceau
+     * @param k Indice du morceau (0 : avant la première date)
+     * @return Valeur
+     */
+    double piece(std::size_t k) const;
+
+public:
+    /**
+     * @brief Courbe constante
+     * @param value Valeur
+     */
+    explicit Piecewise_curve(double value = 0.0);
+
+    /**
+     * @brief Courbe constante par morceaux
+     * @param times Dates de changement de valeur, strictement croissantes
+     * @param values Valeurs sur chaque morceau (une de plus que de dates)
+     * @throw std::invalid_argument si les tailles ne correspondent pas ou si les dates ne sont pas croissantes
+     */
+    Piecewise_curve(const std::vector<double>& times, const std::vector<double>& values);
+
+    /**
+     * @brief Valeur de la courbe
+     * @param t Temps calendaire
+     * @return Valeur sur le morceau contenant t
+     */
+    double value(double t) const;
+
+    /**
+     * @brief Intégrale de la courbe
+     * @param t0 Début
+     * @param t1 Fin (t1 >= t0)
+     * @return Intégrale sur [t0, t1]
+     */
+    double integral(double t0, double t1) const;
+
+    /**
+     * @brief Intégrale du carré de la courbe (variance cumulée pour une volatilité)
+     * @param t0 Début
+     * @param t1 Fin (t1 >= t0)
+     * @return Intégrale du carré sur [t0, t1]
+     */
+    double integral_squared(double t0, double t1) const;
+
+    /**
+     * @brief Getter pour les dates de changement de valeur
+     * @return Dates croissantes
+     */
+    const std::vector<double>& times() const;
+
+    /**
+     * @brief Indique si la courbe est constante
+     * @return true si la courbe n'a qu'un morceau
+     */
+    bool is_flat() const;
+};
+
+
+#endif // TERM_STRUCTURE_HPP
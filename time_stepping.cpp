@@ -0,0 +1,267 @@
+/**
+ * @file time_stepping.cpp
+ * @author Mathias LE BOUEDEC - Lilou MALFOY
+ * @date 2025
+ * @brief Implémentation des schémas en temps communs aux solveurs
+ */
+
+#include "time_stepping.hpp"
+#include "workspace.hpp"
+#include <cmath>
+
+
+/**
+ * @brief Constructeur
+ * @param N Indice du dernier noeud de la grille
+ */
+Time_stepper::Time_stepper(int N)
+    : op_(nullptr), N_(N), n_cached_(0), next_slot_(0), factorizations_(0), solves_(0) {
+    Workspace_pool& pool = Workspace_pool::local();
+    pool.acquire(N_ + 1, rhs_);
+    pool.acquire(N_ + 1, dp_);
+}
+
+/**
+ * @brief Constructeur de copie (tampons propres, cache vide)
+ * @param other Pas de temps copié
+ */
+Time_stepper::Time_stepper(const Time_stepper& other)
+    : op_(other.op_), N_(other.N_), n_cached_(0), next_slot_(0), factorizations_(0), solves_(0) {
+    Workspace_pool& pool = Workspace_pool::local();
+    pool.acquire(N_ + 1, rhs_);
+    pool.acquire(N_ + 1, dp_);
+}
+
+/**
+ * @brief Destructeur (rend les tampons au pool du thread)
+ */
+Time_stepper::~Time_stepper() {
+    Workspace_pool& pool = Workspace_pool::local();
+    pool.release(rhs_);
+    pool.release(dp_);
+    for (std::size_t k = 0; k < n_cached_; ++k) {
+        pool.release(cache_[k].cp);
+        pool.release(cache_[k].inv);
+    }
+}
+
+/**
+ * @brief Change l'opérateur spatial et vide le cache de factorisations
+ * @param op Opérateur (doit rester valide pendant son utilisation)
+ */
+void Time_stepper::set_operator(const Tridiagonal_operator& op) {
+    op_ = &op;
+    for (std::size_t k = 0; k < n_cached_; ++k) cache_[k].c = std::nan(""); //entrées invalidées, mémoire conservée
+}
+
+/**
+ * @brief Rend les factorisations au pool du thread appelant et vide le cache
+ */
+void Time_stepper::release_factorizations() {
+    Workspace_pool& pool = Workspace_pool::local();
+    for (std::size_t k = 0; k < n_cached_; ++k) {
+        pool.release(cache_[k].cp);
+        pool.release(cache_[k].inv);
+    }
+    n_cached_ = 0;
+    next_slot_ = 0;
+}
+
+/**
+ * @brief Getter pour l'opérateur courant
+ * @return Pointeur vers l'opérateur (nullptr avant set_operator)
+ */
+const Tridiagonal_operator* Time_stepper::get_operator() const {
+    return op_;
+}
+
+/**
+ * @brief Factorisation de (I - c A), calculée si absente du cache
+ * @param c Coefficient du système
+ * @return Référence vers la factorisation
+ */
+const Time_stepper::Factorization& Time_stepper::factorization(double c) {
+    for (std::size_t k = 0; k < n_cached_; ++k) {
+        if (cache_[k].c == c) return cache_[k];
+    }
+
+    std::size_t slot;
+    if (n_cached_ < max_cached) {
+        slot = n_cached_++;
+        Workspace_pool& pool = Workspace_pool::local();
+        pool.acquire(N_ + 1, cache_[slot].cp);
+        pool.acquire(N_ + 1, cache_[slot].inv);
+    } else {
+        slot = next_slot_;
+        next_slot_ = (next_slot_ + 1) % max_cached;
+    }
+
+    //élimination de Thomas sur les noeuds intérieurs : a_i = -c l_i, b_i = 1 - c d_i, c_i = -c u_i
+    Factorization& f = cache_[slot];
+    f.c = c;
+    const Tridiagonal_operator& A = *op_;
+    double prev_cp = 0.0;
+    for (int i = 1; i < N_; ++i) {
+        double a = -c * A.lower[i];
+        double denom = 1.0 - c * A.diag[i] - a * prev_cp;
+        if (std::abs(denom) < 1e-20) denom = 1e-20;
+        f.inv[i] = 1.0 / denom;
+        f.cp[i] = -c * A.upper[i] * f.inv[i];
+        prev_cp = f.cp[i];
+    }
+    factorizations_++;
+    return f;
+}
+
+/**
+ * @brief Calcule out = A u sur les noeuds intérieurs
+ * @param u Vecteur sur la grille
+ * @param out Résultat (noeuds 1..N-1)
+ */
+void Time_stepper::apply(const std::vector<double>& u, std::vector<double>& out) const {
+    const Tridiagonal_operator& A = *op_;
+    for (int i = 1; i < N_; ++i) {
+        out[i] = A.lower[i] * u[i - 1] + A.diag[i] * u[i] + A.upper[i] * u[i + 1];
+    }
+}
+
+/**
+ * @brief Résout (I - c A) u_new = f sur les noeuds intérieurs, bords de u_new déjà fixés
+ * @param c Coefficient du système
+ * @param f Membre de droite (noeuds 1..N-1), modifié
+ * @param u_new Solution
+ */
+void Time_stepper::solve_shifted(double c, std::vector<double>& f, std::vector<double>& u_new) {
+    const Tridiagonal_operator& A = *op_;
+    const Factorization& fac = factorization(c);
+
+    //conditions aux limites passées dans le membre de droite
+    f[1] += c * A.lower[1] * u_new[0];
+    f[N_ - 1] += c * A.upper[N_ - 1] * u_new[N_];
+
+    //descente puis remontée avec la factorisation conservée
+    double prev = 0.0;
+    for (int i = 1; i < N_; ++i) {
+        prev = (f[i] + c * A.lower[i] * prev) * fac.inv[i];
+        dp_[i] = prev;
+    }
+    u_new[N_ - 1] = dp_[N_ - 1];
+    for (int i = N_ - 2; i >= 1; --i) {
+        u_new[i] = dp_[i] - fac.cp[i] * u_new[i + 1];
+    }
+    solves_++;
+}
+
+/**
+ * @brief Calcule out = A^T lambda restreint aux noeuds intérieurs (lambda nul aux bords)
+ * @param lambda Vecteur adjoint sur la grille (noeuds 1..N-1 utilisés)
+ * @param out Résultat (noeuds 1..N-1)
+ */
+void Time_stepper::apply_transpose(const std::vector<double>& lambda, std::vector<double>& out) const {
+    const Tridiagonal_operator& A = *op_;
+    for (int j = 1; j < N_; ++j) {
+        double s = A.diag[j] * lambda[j];
+        if (j > 1) s += A.upper[j - 1] * lambda[j - 1];
+        if (j < N_ - 1) s += A.lower[j + 1] * lambda[j + 1];
+        out[j] = s;
+    }
+}
+
+/**
+ * @brief Résout (I - c A)^T lambda = f sur les noeuds intérieurs avec la factorisation conservée
+ * @param c Coefficient du système
+ * @param f Membre de droite (noeuds 1..N-1)
+ * @param lambda Solution (noeuds 1..N-1, bords mis à zéro)
+ */
+void Time_stepper::solve_shifted_transpose(double c, const std::vector<double>& f, std::vector<double>& lambda) {
+    const Tridiagonal_operator& A = *op_;
+    const Factorization& fac = factorization(c);
+
+    //(I - c A) = L U avec L bidiagonale (pivots 1/inv, sous-diagonale -c l_i) et U unitaire (sur-diagonale cp) :
+    //on résout U^T z = f puis L^T lambda = z
+    double prev = 0.0;
+    for (int i = 1; i < N_; ++i) {
+        prev = f[i] - (i > 1 ? fac.cp[i - 1] * prev : 0.0);
+        dp_[i] = prev;
+    }
+    lambda[N_ - 1] = dp_[N_ - 1] * fac.inv[N_ - 1];
+    for (int i = N_ - 2; i >= 1; --i) {
+        lambda[i] = (dp_[i] + c * A.lower[i + 1] * lambda[i + 1]) * fac.inv[i];
+    }
+    lambda[0] = 0.0;
+    lambda[N_] = 0.0;
+    solves_++;
+}
+
+/**
+ * @brief Pas du theta-schéma (theta=1/2 : Crank-Nicolson, theta=1 : Euler implicite)
+ * @param u_old Solution au temps tau
+ * @param u_new Solution au temps tau + dt (bords fixés)
+ * @param dt Pas de temps
+ * @param theta Paramètre d'implicitation
+ */
+void Time_stepper::theta_step(const std::vector<double>& u_old, std::vector<double>& u_new, double dt, double theta) {
+    if (theta < 1.0) {
+        apply(u_old, rhs_);
+        double w = (1.0 - theta) * dt;
+        for (int i = 1; i < N_; ++i) rhs_[i] = u_old[i] + w * rhs_[i];
+    } else {
+        for (int i = 1; i < N_; ++i) rhs_[i] = u_old[i];
+    }
+    solve_shifted(theta * dt, rhs_, u_new);
+}
+
+/**
+ * @brief Pas BDF2 à pas constant
+ * @param u_old Solution au temps tau
+ * @param u_older Solution au temps tau - dt
+ * @param u_new Solution au temps tau + dt (bords fixés)
+ * @param dt Pas de temps
+ */
+void Time_stepper::bdf2_step(const std::vector<double>& u_old, const std::vector<double>& u_older, std::vector<double>& u_new, double dt) {
+    //(3 u_new - 4 u_old + u_older) / (2 dt) = A u_new
+    for (int i = 1; i < N_; ++i) rhs_[i] = (4.0 * u_old[i] - u_older[i]) / 3.0;
+    solve_shifted(2.0 * dt / 3.0, rhs_, u_new);
+}
+
+/**
+ * @brief Pas TR-BDF2 : trapèze jusqu'à tau + gamma dt puis BDF2
+ * @param u_old Solution au temps tau
+ * @param u_stage Étape intermédiaire (bords fixés au temps tau + gamma dt)
+ * @param u_new Solution au temps tau + dt (bords fixés)
+ * @param dt Pas de temps
+ */
+void Time_stepper::tr_bdf2_step(const std::vector<double>& u_old, std::vector<double>& u_stage, std::vector<double>& u_new, double dt) {
+    const double g = tr_bdf2_gamma();
+    theta_step(u_old, u_stage, g * dt, 0.5);
+
+    //avec gamma = 2 - sqrt(2), les deux étapes ont le même coefficient c : une seule factorisation
+    double w_stage = 1.0 / (g * (2.0 - g));
+    double w_old = (1.0 - g) * (1.0 - g) / (g * (2.0 - g));
+    for (int i = 1; i < N_; ++i) rhs_[i] = w_stage * u_stage[i] - w_old * u_old[i];
+    solve_shifted(0.5 * (g * dt), rhs_, u_new); //(1 - gamma) / (2 - gamma) = gamma / 2
+}
+
+/**
+ * @brief Fraction du pas occupée par l'étape trapèze de TR-BDF2
+ * @return gamma = 2 - sqrt(2)
+ */
+double Time_stepper::tr_bdf2_gamma() {
+    return 2.0 - std::sqrt(2.0);
+}
+
+/**
+ * @brief Nombre de factorisations calculées depuis la création
+ * @return Compteur de factorisations
+ */
+unsigned long Time_stepper::factorization_count() const {
+    return factorizations_;
+}
+
+/**
+ * @brief Nombre de systèmes tridiagonaux résolus depuis la création
+ * @return Compteur de résolutions
+ */
+unsigned long Time_stepper::solve_count() const {
+    return solves_;
+}
@@ -0,0 +1,189 @@
+/**
+ * @file time_stepping.hpp
+ * @author Mathias LE BOUEDEC - Lilou MALFOY
+ * @date 2025
+ * @brief Schémas en temps communs aux solveurs : theta-schéma, Rannacher, BDF2 et TR-BDF2
+ */
+
+#ifndef TIME_STEPPING_HPP
+#define TIME_STEPPING_HPP
+
+#include <vector>
+
+
+/**
+ * @brief Schéma d'intégration en temps
+ */
+enum Time_scheme {
+    SCHEME_CRANK_NICOLSON, // theta = 1/2, ordre 2, oscille sur un payoff non régulier
+    SCHEME_IMPLICIT,       // Euler implicite, ordre 1, L-stable
+    SCHEME_RANNACHER,      // quelques demi-pas implicites au départ puis Crank-Nicolson
+    SCHEME_BDF2,           // BDF2 à deux pas (démarré par deux demi-pas implicites), ordre 2, L-stable
+    SCHEME_TR_BDF2         // TR-BDF2 à un pas, ordre 2, L-stable
+};
+
+
+/**
+ * @brief Opérateur spatial tridiagonal A : (A u)_i = lower_i u_{i-1} + diag_i u_i + upper_i u_{i+1}
+ *
+ * Les vecteurs ont la taille de la grille (N+1) ; seuls les noeuds intérieurs 1..N-1 sont utilisés.
+ */
+struct Tridiagonal_operator {
+    std::vector<double> lower; // coefficient de u_{i-1}
+    std::vector<double> diag;  // coefficient de u_i
+    std::vector<double> upper; // coefficient de u_{i+1}
+};
+
+
+/**
+ * @brief Avance la semi-discrétisation du/dtau = A u d'un pas, conditions de Dirichlet aux deux bords
+ *
+ * Tous les systèmes résolus sont de la forme (I - c A) u = f ; la factorisation de Thomas
+ * est conservée pour chaque valeur de c et réutilisée tant que l'opérateur ne change pas.
+ * Les valeurs aux bords (indices 0 et N) du vecteur d'arrivée doivent être fixées par l'appelant.
+ */
+class Time_stepper {
+private:
+    /**
+     * @brief Factorisation de Thomas de (I - c A)
+     */
+    struct Factorization {
+        double c;                // coefficient du système
+        std::vector<double> cp;  // coefficients supérieurs modifiés
+        std::vector<double> inv; // inverses des pivots
+    };
+
+    static const std::size_t max_cached = 8;
+
+    const Tridiagonal_operator* op_;  // opérateur courant
+    int N_;                           // indice du dernier noeud
+    Factorization cache_[max_cached]; // factorisations conservées (tableau fixe : aucune allocation du cache lui-même)
+    std::size_t n_cached_;            // entrées utilisées dans cache_
+    std::size_t next_slot_;           // prochaine entrée remplacée quand le cache est plein
+    std::vector<double> rhs_, dp_;    // tampons
+    unsigned long factorizations_;    // nombre de factorisations calculées
+    unsigned long solves_;            // nombre de systèmes résolus
+
+    /**
+     * @brief Factorisation de (I - c A), calculée si absente du cache
+     * @param c Coefficient du système
+     * @return Référence vers la factorisation
+     */
+    const Factorization& factorization(double c);
+
+public:
+    /**
+     * @brief Constructeur
+     * @param N Indice du dernier noeud de la grille
+     */
+    explicit Time_stepper(int N);
+
+    /**
+     * @brief Destructeur (rend les tampons au pool du thread)
+     */
+    ~Time_stepper();
+
+    /**
+     * @brief Constructeur de copie (tampons propres, cache vide)
+     * @param other Pas de temps copié
+     */
+    Time_stepper(const Time_stepper& other);
+
+    /**
+     * @brief Change l'opérateur spatial et vide le cache de factorisations
+     * @param op Opérateur (doit rester valide pendant son utilisation)
+     */
+    void set_operator(const Tridiagonal_operator& op);
+
+    /**
+     * @brief Rend les factorisations au pool du thread appelant et vide le cache
+     *
+     * À appeler depuis le thread qui les a calculées quand il n'est pas celui qui détruira le pas de temps
+     * (propagateurs fins de parareal) : chaque tampon retourne au pool dont il vient.
+     */
+    void release_factorizations();
+
+    /**
+     * @brief Getter pour l'opérateur courant
+     * @return Pointeur vers l'opérateur (nullptr avant set_operator)
+     */
+    const Tridiagonal_operator* get_operator() const;
+
+    /**
+     * @brief Calcule out = A u sur les noeuds intérieurs
+     * @param u Vecteur sur la grille
+     * @param out Résultat (noeuds 1..N-1)
+     */
+    void apply(const std::vector<double>& u, std::vector<double>& out) const;
+
+    /**
+     * @brief Résout (I - c A) u_new = f sur les noeuds intérieurs, bords de u_new déjà fixés
+     * @param c Coefficient du système
+     * @param f Membre de droite (noeuds 1..N-1), modifié
+     * @param u_new Solution
+     */
+    void solve_shifted(double c, std::vector<double>& f, std::vector<double>& u_new);
+
+    /**
+     * @brief Calcule out = A^T lambda restreint aux noeuds intérieurs (lambda nul aux bords)
+     * @param lambda Vecteur adjoint sur la grille (noeuds 1..N-1 utilisés)
+     * @param out Résultat (noeuds 1..N-1)
+     */
+    void apply_transpose(const std::vector<double>& lambda, std::vector<double>& out) const;
+
+    /**
+     * @brief Résout (I - c A)^T lambda = f sur les noeuds intérieurs avec la factorisation conservée
+     * @param c Coefficient du système
+     * @param f Membre de droite (noeuds 1..N-1)
+     * @param lambda Solution (noeuds 1..N-1, bords mis à zéro)
+     */
+    void solve_shifted_transpose(double c, const std::vector<double>& f, std::vector<double>& lambda);
+
+    /**
+     * @brief Pas du theta-schéma (theta=1/2 : Crank-Nicolson, theta=1 : Euler implicite)
+     * @param u_old Solution au temps tau
+     * @param u_new Solution au temps tau + dt (bords fixés)
+     * @param dt Pas de temps
+     * @param theta Paramètre d'implicitation
+     */
+    void theta_step(const std::vector<double>& u_old, std::vector<double>& u_new, double dt, double theta);
+
+    /**
+     * @brief Pas BDF2 à pas constant
+     * @param u_old Solution au temps tau
+     * @param u_older Solution au temps tau - dt
+     * @param u_new Solution au temps tau + dt (bords fixés)
+     * @param dt Pas de temps
+     */
+    void bdf2_step(const std::vector<double>& u_old, const std::vector<double>& u_older, std::vector<double>& u_new, double dt);
+
+    /**
+     * @brief Pas TR-BDF2 : trapèze jusqu'à tau + gamma dt puis BDF2
+     * @param u_old Solution au temps tau
+     * @param u_stage Étape intermédiaire (bords fixés au temps tau + gamma dt)
+     * @param u_new Solution au temps tau + dt (bords fixés)
+     * @param dt Pas de temps
+     */
+    void tr_bdf2_step(const std::vector<double>& u_old, std::vector<double>& u_stage, std::vector<double>& u_new, double dt);
+
+    /**
+     * @brief Fraction du pas occupée par l'étape trapèze de TR-BDF2
+     * @return gamma = 2 - sqrt(2)
+     */
+    static double tr_bdf2_gamma();
+
+    /**
+     * @brief Nombre de factorisations calculées depuis la création
+     * @return Compteur de factorisations
+     */
+    unsigned long factorization_count() const;
+
+    /**
+     * @brief Nombre de systèmes tridiagonaux résolus depuis la création
+     * @return Compteur de résolutions
+     */
+    unsigned long solve_count() const;
+};
+
+
+#endif // TIME_STEPPING_HPP
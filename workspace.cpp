@@ -0,0 +1,209 @@
+/**
+ * @file workspace.cpp
+ * @author Mathias LE BOUEDEC - Lilou MALFOY
+ * @date 2025
+ * @brief Implémentation du pool de mémoire de travail réutilisable entre solveurs
+ */
+
+#include "workspace.hpp"
+
+
+/**
+ * @brief Constructeur du pool
+ * @param max_per_class Nombre maximal d'éléments conservés par classe de taille
+ *        (un solveur avec ses factorisations et sa passe adjointe tient une vingtaine de vecteurs de taille N+1)
+ * @param max_bytes Nombre maximal d'octets conservés (64 Mo par défaut, soit huit matrices 1000 x 1000)
+ */
+Workspace_pool::Workspace_pool(std::size_t max_per_class, std::size_t max_bytes)
+    : max_per_class_(max_per_class), max_bytes_(max_bytes) {
+    stats_.bytes_cached = 0;
+    reset_stats();
+}
+
+/**
+ * @brief Pool du thread courant
+ * @return Référence vers le pool local au thread
+ */
+Workspace_pool& Workspace_pool::local() {
+    static thread_local Workspace_pool pool; //un pool par thread : aucune contention entre threads
+    return pool;
+}
+
+/**
+ * @brief Emprunte un vecteur de n valeurs (contenu non spécifié)
+ * @param n Longueur demandée
+ * @param out Vecteur qui reçoit le tampon (son ancien contenu est rendu au pool)
+ */
+void Workspace_pool::acquire(std::size_t n, std::vector<double>& out) {
+    release(out);
+    unsigned long long bytes = n * sizeof(double);
+    std::map<std::size_t, std::vector<Buffer> >::iterator it = buffers_.find(n);
+    if (it != buffers_.end() && !it->second.empty()) {
+        out.swap(it->second.back()); //échange des pointeurs : pas de copie
+        it->second.pop_back();
+        if (it->second.empty()) buffers_.erase(it); //pas de classe vide : leur nombre reste borné par le budget
+        stats_.bytes_reused += bytes;
+        stats_.bytes_cached -= bytes;
+        stats_.reuses++;
+    } else {
+        out.assign(n, 0.0);
+        stats_.bytes_allocated += bytes;
+        stats_.allocations++;
+    }
+}
+
+/**
+ * @brief Emprunte une matrice rows x cols (contenu non spécifié)
+ * @param rows Nombre de lignes
+ * @param cols Nombre de colonnes
+ * @param out Matrice qui reçoit le tampon (son ancien contenu est rendu au pool)
+ */
+void Workspace_pool::acquire(std::size_t rows, std::size_t cols, std::vector< std::vector<double> >& out) {
+    release(out);
+    unsigned long long bytes = rows * cols * sizeof(double);
+    std::map<std::pair<std::size_t, std::size_t>, std::vector<Surface> >::iterator it =
+        surfaces_.find(std::make_pair(rows, cols));
+    if (it != surfaces_.end() && !it->second.empty()) {
+        out.swap(it->second.back());
+        it->second.pop_back();
+        if (it->second.empty()) surfaces_.erase(it);
+        stats_.bytes_reused += bytes;
+        stats_.bytes_cached -= bytes;
+        stats_.reuses++;
+    } else {
+        out.assign(rows, std::vector<double>(cols, 0.0));
+        stats_.bytes_allocated += bytes;
+        stats_.allocations++;
+    }
+}
+
+/**
+ * @brief Rend un vecteur au pool (le vecteur est vidé)
+ * @param buffer Vecteur rendu
+ */
+void Workspace_pool::release(std::vector<double>& buffer) {
+    if (buffer.empty()) return;
+    unsigned long long bytes = buffer.size() * sizeof(double);
+    std::map<std::size_t, std::vector<Buffer> >::iterator it = buffers_.find(buffer.size());
+    bool full = it != buffers_.end() && it->second.size() >= max_per_class_;
+    if (full || bytes > max_bytes_) {
+        Buffer().swap(buffer); //classe pleine ou tampon hors budget : la mémoire est rendue au système
+        stats_.evictions += !full;
+        return;
+    }
+    evict_to(max_bytes_ - bytes);
+    std::vector<Buffer>& free_list = buffers_[buffer.size()];
+    stats_.bytes_cached += bytes;
+    free_list.push_back(Buffer());
+    free_list.back().swap(buffer);
+}
+
+/**
+ * @brief Rend une matrice au pool (la matrice est vidée)
+ * @param surface Matrice rendue
+ */
+void Workspace_pool::release(std::vector< std::vector<double> >& surface) {
+    if (surface.empty()) return;
+    std::size_t rows = surface.size(), cols = surface[0].size();
+    for (std::size_t j = 1; j < rows; ++j) {
+        if (surface[j].size() != cols) { Surface().swap(surface); return; } //matrice irrégulière : non recyclée
+    }
+    unsigned long long bytes = rows * cols * sizeof(double);
+    std::map<std::pair<std::size_t, std::size_t>, std::vector<Surface> >::iterator it =
+        surfaces_.find(std::make_pair(rows, cols));
+    bool full = it != surfaces_.end() && it->second.size() >= max_per_class_;
+    if (full || bytes > max_bytes_) {
+        Surface().swap(surface);
+        stats_.evictions += !full;
+        return;
+    }
+    evict_to(max_bytes_ - bytes);
+    std::vector<Surface>& free_list = surfaces_[std::make_pair(rows, cols)];
+    stats_.bytes_cached += bytes;
+    free_list.push_back(Surface());
+    free_list.back().swap(surface);
+}
+
+/**
+ * @brief Rend au système les éléments les plus gros jusqu'à ce que le pool tienne en max_bytes octets
+ * @param max_bytes Octets conservés au plus
+ */
+void Workspace_pool::evict_to(unsigned long long max_bytes) {
+    while (stats_.bytes_cached > max_bytes) {
+        //plus gros vecteur : dernière classe de la table triée par longueur ; plus grosse matrice : parcours des classes
+        unsigned long long buffer_bytes = buffers_.empty() ? 0 : buffers_.rbegin()->first * sizeof(double);
+        std::map<std::pair<std::size_t, std::size_t>, std::vector<Surface> >::iterator largest = surfaces_.end();
+        unsigned long long surface_bytes = 0;
+        for (std::map<std::pair<std::size_t, std::size_t>, std::vector<Surface> >::iterator it = surfaces_.begin();
+             it != surfaces_.end(); ++it) {
+            unsigned long long b = it->first.first * it->first.second * sizeof(double);
+            if (b > surface_bytes) { surface_bytes = b; largest = it; }
+        }
+
+        if (surface_bytes >= buffer_bytes && largest != surfaces_.end()) {
+            largest->second.pop_back();
+            if (largest->second.empty()) surfaces_.erase(largest);
+            stats_.bytes_cached -= surface_bytes;
+        } else if (!buffers_.empty()) {
+            std::map<std::size_t, std::vector<Buffer> >::iterator it = --buffers_.end();
+            it->second.pop_back();
+            if (it->second.empty()) buffers_.erase(it);
+            stats_.bytes_cached -= buffer_bytes;
+        } else {
+            break;
+        }
+        stats_.evictions++;
+    }
+}
+
+/**
+ * @brief Getter pour les compteurs du pool
+ * @return Octets alloués, réutilisés et conservés
+ */
+Workspace_stats Workspace_pool::stats() const {
+    return stats_;
+}
+
+/**
+ * @brief Libère toute la mémoire conservée dans le pool
+ */
+void Workspace_pool::clear() {
+    buffers_.clear();
+    surfaces_.clear();
+    stats_.bytes_cached = 0;
+}
+
+/**
+ * @brief Libère la mémoire conservée au-delà de max_bytes octets, les éléments les plus gros en premier
+ * @param max_bytes Octets conservés au plus (0 : tout libérer)
+ */
+void Workspace_pool::trim(std::size_t max_bytes) {
+    if (max_bytes == 0) clear();
+    else evict_to(max_bytes);
+}
+
+/**
+ * @brief Change le budget en octets du pool (appliqué immédiatement)
+ * @param max_bytes Nombre maximal d'octets conservés
+ */
+void Workspace_pool::set_max_bytes(std::size_t max_bytes) {
+    max_bytes_ = max_bytes;
+    evict_to(max_bytes_);
+}
+
+/**
+ * @brief Getter pour le budget en octets
+ * @return Nombre maximal d'octets conservés
+ */
+std::size_t Workspace_pool::max_bytes() const {
+    return max_bytes_;
+}
+
+/**
+ * @brief Remet les compteurs à zéro
+ */
+void Workspace_pool::reset_stats() {
+    unsigned long long cached = stats_.bytes_cached;
+    stats_.bytes_allocated = stats_.bytes_reused = stats_.allocations = stats_.reuses = stats_.evictions = 0;
+    stats_.bytes_cached = cached;
+}
@@ -0,0 +1,135 @@
+/**
+ * @file workspace.hpp
+ * @author Mathias LE BOUEDEC - Lilou MALFOY
+ * @date 2025
+ * @brief Définition du pool de mémoire de travail réutilisable entre solveurs (un pool par thread)
+ */
+
+#ifndef WORKSPACE_HPP
+#define WORKSPACE_HPP
+
+#include <cstddef>
+#include <map>
+#include <utility>
+#include <vector>
+
+
+/**
+ * @brief Compteurs d'utilisation d'un pool
+ */
+struct Workspace_stats {
+    unsigned long long bytes_allocated; // octets obtenus par de nouvelles allocations
+    unsigned long long bytes_reused;    // octets servis depuis le pool sans allocation
+    unsigned long long allocations;     // nombre de nouvelles allocations
+    unsigned long long reuses;          // nombre de réutilisations
+    unsigned long long bytes_cached;    // octets actuellement conservés dans le pool
+    unsigned long long evictions;       // éléments rendus au système pour tenir dans le budget en octets
+};
+
+
+/**
+ * @brief Pool de vecteurs et de matrices classés par taille, local à chaque thread
+ *
+ * Les solveurs empruntent leurs grilles, leur matrice de solutions et leurs
+ * tampons de calcul au pool de leur thread, et les rendent à leur destruction :
+ * les tailles identiques (même N, M) sont recyclées sans nouvelle allocation.
+ * La mémoire conservée est bornée par classe (nombre d'éléments) et au total (octets) :
+ * au-delà du budget, les éléments les plus gros sont rendus au système en premier.
+ * Un tampon doit être rendu au pool du thread qui l'a emprunté.
+ */
+class Workspace_pool {
+private:
+    typedef std::vector<double> Buffer;
+    typedef std::vector<Buffer> Surface;
+
+    std::map<std::size_t, std::vector<Buffer> > buffers_;  // vecteurs libres, par longueur
+    std::map<std::pair<std::size_t, std::size_t>, std::vector<Surface> > surfaces_; // matrices libres, par (lignes, colonnes)
+    std::size_t max_per_class_; // nombre maximal d'éléments conservés par classe de taille
+    std::size_t max_bytes_;     // nombre maximal d'octets conservés dans le pool
+    Workspace_stats stats_;
+
+    /**
+     * @brief Rend au système les éléments les plus gros jusqu'à ce que le pool tienne en max_bytes octets
+     * @param max_bytes Octets conservés au plus
+     */
+    void evict_to(unsigned long long max_bytes);
+
+public:
+    /**
+     * @brief Constructeur du pool
+     * @param max_per_class Nombre maximal d'éléments conservés par classe de taille
+     *        (un solveur avec ses factorisations et sa passe adjointe tient une vingtaine de vecteurs de taille N+1)
+     * @param max_bytes Nombre maximal d'octets conservés (64 Mo par défaut, soit huit matrices 1000 x 1000)
+     */
+    explicit Workspace_pool(std::size_t max_per_class = 32, std::size_t max_bytes = 64u << 20);
+
+    /**
+     * @brief Pool du thread courant
+     * @return Référence vers le pool local au thread
+     */
+    static Workspace_pool& local();
+
+    /**
+     * @brief Emprunte un vecteur de n valeurs (contenu non spécifié)
+     * @param n Longueur demandée
+     * @param out Vecteur qui reçoit le tampon (son ancien contenu est rendu au pool)
+     */
+    void acquire(std::size_t n, std::vector<double>& out);
+
+    /**
+     * @brief Emprunte une matrice rows x cols (contenu non spécifié)
+     * @param rows Nombre de lignes
+     * @param cols Nombre de colonnes
+     * @param out Matrice qui reçoit le tampon (son ancien contenu est rendu au pool)
+     */
+    void acquire(std::size_t rows, std::size_t cols, std::vector< std::vector<double> >& out);
+
+    /**
+     * @brief Rend un vecteur au pool (le vecteur est vidé)
+     * @param buffer Vecteur rendu
+     */
+    void release(std::vector<double>& buffer);
+
+    /**
+     * @brief Rend une matrice au pool (la matrice est vidée)
+     * @param surface Matrice rendue
+     */
+    void release(std::vector< std::vector<double> >& surface);
+
+    /**
+     * @brief Getter pour les compteurs du pool
+     * @return Octets alloués, réutilisés et conservés
+     */
+    Workspace_stats stats() const;
+
+    /**
+     * @brief Libère toute la mémoire conservée dans le pool
+     */
+    void clear();
+
+    /**
+     * @brief Libère la mémoire conservée au-delà de max_bytes octets, les éléments les plus gros en premier
+     * @param max_bytes Octets conservés au plus (0 : tout libérer)
+     */
+    void trim(std::size_t max_bytes = 0);
+
+    /**
+     * @brief Change le budget en octets du pool (appliqué immédiatement)
+     * @param max_bytes Nombre maximal d'octets conservés
+     */
+    void set_max_bytes(std::size_t max_bytes);
+
+    /**
+     * @brief Getter pour le budget en octets
+     * @return Nombre maximal d'octets conservés
+     */
+    std::size_t max_bytes() const;
+
+    /**
+     * @brief Remet les compteurs à zéro
+     */
+    void reset_stats();
+};
+
+
+#endif // WORKSPACE_HPP